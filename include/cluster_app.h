@@ -0,0 +1,75 @@
+#ifndef CLUSTER_APP_H
+#define CLUSTER_APP_H
+
+#include "ns3/application.h"
+#include "ns3/socket.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/random-variable-stream.h"
+#include "memostp_protocol.h"
+#include "cluster_manager.h"
+#include "data_aggregator.h"
+#include <vector>
+#include <deque>
+#include <cstdint>
+
+class DutyCycleScheduler;
+
+// Sensor traffic for the clustered mode. Every node runs one instance:
+// members send each reading to their current cluster head, heads fold what
+// they receive (and their own readings) into a DataAggregator and forward
+// one encrypted frame to the sink per aggregation window, and the sink
+// counts delivered readings. All payloads are encrypted through the MEMOSTP
+// protocol.
+class ClusterTrafficApplication : public ns3::Application {
+public:
+    ClusterTrafficApplication();
+    
+    static ns3::TypeId GetTypeId();
+    
+    void Setup(ClusterManager* clusters, EnhancedMEMOSTPProtocol* protocol, uint32_t nodeId,
+               const std::vector<ns3::Ipv4Address>& addresses, uint16_t port,
+               double readingInterval, double aggregationWindow,
+               DataAggregator::Function function, uint32_t concatCap);
+    
+    // Hold frames outside the duty-cycle rendezvous interval, when the head,
+    // the sink or a relay may be asleep, and send them when it next opens
+    void SetDutyCycle(DutyCycleScheduler* scheduler) { m_dutyCycle = scheduler; }
+    
+    void StartApplication() override;
+    void StopApplication() override;
+    
+private:
+    void GenerateReading();
+    void AddToAggregate(uint32_t source, double time, double value);
+    void SendAggregate();
+    void ForwardAggregate();
+    void HandleRead(ns3::Ptr<ns3::Socket> socket);
+    void SendTo(uint32_t nodeId, const std::vector<uint8_t>& plaintext);
+    void FlushPending();
+    
+    ClusterManager* m_clusters;
+    EnhancedMEMOSTPProtocol* m_protocol;
+    uint32_t m_nodeId;
+    std::vector<ns3::Ipv4Address> m_addresses;
+    uint16_t m_port;
+    double m_readingInterval;
+    double m_aggregationWindow;
+    
+    ns3::Ptr<ns3::Socket> m_socket;
+    ns3::Ptr<ns3::UniformRandomVariable> m_sensor;
+    DataAggregator m_aggregator;
+    uint32_t m_packetCounter;
+    ns3::EventId m_readingEvent;
+    ns3::EventId m_forwardEvent;
+    
+    struct PendingFrame {
+        ns3::Ptr<ns3::Packet> packet;
+        uint32_t destination;
+        double queuedAt;
+    };
+    DutyCycleScheduler* m_dutyCycle;
+    std::deque<PendingFrame> m_pending;
+    ns3::EventId m_flushEvent;
+};
+
+#endif // CLUSTER_APP_H
@@ -0,0 +1,76 @@
+#ifndef CLUSTER_MANAGER_H
+#define CLUSTER_MANAGER_H
+
+#include "ns3/core-module.h"
+#include "node_monitor.h"
+#include <vector>
+#include <cstdint>
+
+// LEACH-style cluster-head election with energy-aware rotation.
+//
+// Each round every alive non-sink node that has not been head in the last
+// 1/p rounds draws against the LEACH threshold
+//     T = p / (1 - p * (r mod 1/p))
+// scaled by w * (residual / initial energy) + (1 - w), where w is the
+// optimizer's energy weight. The epoch rule guarantees each node serves at
+// most once per 1/p rounds; the energy term keeps low-battery nodes out of
+// the draw. Members join the nearest head; nodes with no head in range of
+// the election send straight to the sink.
+class ClusterManager {
+public:
+    ClusterManager();
+
+    void Configure(NodeMonitor& monitor, uint32_t sinkId, double headFraction,
+                   double energyWeight, double roundLength);
+    void Start(double startTime);
+    // Used from the next election on
+    void SetEnergyWeight(double energyWeight);
+    void SetEnergyWeight(const std::vector<double>& energyWeight);
+
+    uint32_t GetHead(uint32_t nodeId) const;
+    bool IsHead(uint32_t nodeId) const;
+    uint32_t GetSink() const { return m_sink; }
+    uint32_t GetRound() const { return m_round; }
+    const std::vector<uint32_t>& GetHeads() const { return m_heads; }
+
+    // Reading accounting, reported by the cluster applications.
+    void RecordReadingGenerated() { m_readingsGenerated++; }
+    void RecordAggregateSent(uint32_t readings) { m_aggregatesSent++; m_readingsForwarded += readings; }
+    void RecordDelivered(uint32_t readings, double latency);
+
+    uint64_t GetReadingsDelivered() const { return m_readingsDelivered; }
+    double GetDeliveryRatio() const;
+    double GetAverageLatency() const;
+
+    void PrintReport() const;
+
+private:
+    void ElectHeads();
+    double ElectionThreshold(uint32_t nodeId) const;
+    void AssignMembers();
+
+    NodeMonitor* m_monitor;
+    uint32_t m_sink;
+    double m_headFraction;
+    double m_energyWeight;
+    std::vector<double> m_nodeEnergyWeight;   // empty = m_energyWeight for every node
+    double m_roundLength;
+    uint32_t m_round;
+
+    std::vector<uint32_t> m_head;          // per node; sink id when unclustered
+    std::vector<uint8_t> m_isHead;
+    std::vector<int64_t> m_lastHeadRound;  // -1 = never
+    std::vector<uint32_t> m_headTerms;
+    std::vector<uint32_t> m_heads;
+    uint64_t m_totalHeads;
+
+    ns3::Ptr<ns3::UniformRandomVariable> m_rng;
+
+    uint64_t m_readingsGenerated;
+    uint64_t m_readingsForwarded;
+    uint64_t m_aggregatesSent;
+    uint64_t m_readingsDelivered;
+    double m_latencySum;
+};
+
+#endif // CLUSTER_MANAGER_H
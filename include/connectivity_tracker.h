@@ -0,0 +1,63 @@
+#ifndef CONNECTIVITY_TRACKER_H
+#define CONNECTIVITY_TRACKER_H
+
+#include "spatial_grid.h"
+#include <vector>
+#include <map>
+#include <cstdint>
+
+// Connected components of the unit-disk radio graph (two live nodes are
+// linked when they are within commRange). The initial labelling is a
+// union-find pass over spatial-grid neighbours; a death re-labels only the
+// component the node belonged to, by BFS from its surviving neighbours.
+// Queries are O(1), so they can be polled every death-check tick.
+class ConnectivityTracker {
+public:
+    ConnectivityTracker();
+
+    void Configure(double areaSize, double commRange, uint32_t sinkId = 0);
+    void AddNode(uint32_t nodeId, double x, double y);
+    void Build();
+
+    void RemoveNode(uint32_t nodeId, double currentTime);
+    bool IsBuilt() const { return built; }
+
+    uint32_t GetComponentCount() const { return componentCount; }
+    uint32_t GetLargestComponentSize() const;
+    double GetLargestComponentRatio() const;   // % of all deployed nodes
+    bool IsSinkReachable(uint32_t nodeId) const;
+    uint32_t GetSinkReachableCount() const;    // live nodes with a path to the sink, sink included
+    double GetSinkReachableRatio() const;      // % of all deployed nodes
+
+    // Time of the first death that split the live nodes into more than one
+    // component, or -1 while the network is still connected.
+    double GetPartitionTime() const { return partitionTime; }
+    double GetCommRange() const { return commRange; }
+
+private:
+    uint32_t Find(uint32_t x);
+    void Relabel(uint32_t start, uint32_t label);
+    void AddComponentSize(uint32_t size);
+    void DropComponentSize(uint32_t size);
+
+    double commRange;
+    uint32_t sinkId;
+    uint32_t nodeCount;
+    bool built;
+
+    SpatialGrid grid;
+    std::vector<uint8_t> alive;
+    std::vector<uint32_t> label;
+    std::vector<uint32_t> componentSize;      // indexed by label
+    std::map<uint32_t, uint32_t> sizeHistogram;
+    uint32_t componentCount;
+    double partitionTime;
+
+    // Scratch for Build() and Relabel()
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> visited;
+    uint32_t visitEpoch;
+    std::vector<uint32_t> queue;
+};
+
+#endif // CONNECTIVITY_TRACKER_H
@@ -0,0 +1,51 @@
+#ifndef COVERAGE_ENGINE_H
+#define COVERAGE_ENGINE_H
+
+#include "spatial_grid.h"
+#include <vector>
+#include <cstdint>
+
+// Geometric sensing coverage over a rasterized square area.
+//
+// The area is split into cellSize x cellSize cells; a cell counts as covered
+// by a node when the cell centre lies within the node's sensing radius. Each
+// cell keeps the number of live nodes covering it, so adding or removing a
+// node only touches the cells of its disk, O(r^2 / cell^2), and the covered
+// and k-covered totals stay current without a rescan.
+class CoverageEngine {
+public:
+    CoverageEngine();
+
+    void Configure(double areaSize, double sensingRadius, double cellSize = 1.0, uint32_t k = 2);
+
+    void AddNode(uint32_t nodeId, double x, double y);
+    void RemoveNode(uint32_t nodeId);
+    bool IsConfigured() const { return !counts.empty(); }
+
+    double GetCoverage() const;      // % of cells covered by >= 1 node
+    double GetKCoverage() const;     // % of cells covered by >= k nodes
+    uint32_t GetK() const { return k; }
+    double GetSensingRadius() const { return sensingRadius; }
+
+    // Live nodes whose sensing disk contains (x, y).
+    uint32_t CountCoveringNodes(double x, double y) const;
+
+    const SpatialGrid& GetGrid() const { return grid; }
+
+private:
+    void StampDisk(double x, double y, int delta);
+
+    double areaSize;
+    double sensingRadius;
+    double cellSize;
+    uint32_t k;
+    int cellsPerSide;
+
+    std::vector<uint16_t> counts;
+    uint64_t coveredCells;
+    uint64_t kCoveredCells;
+
+    SpatialGrid grid;
+};
+
+#endif // COVERAGE_ENGINE_H
@@ -6,9 +6,13 @@
 #include "ns3/address.h"
 #include "ns3/node.h"
 #include "memostp_protocol.h"
+#include "rng_stream.h"
 #include <vector>
+#include <deque>
 #include <cstdint>
 
+class DutyCycleScheduler;
+
 class CryptoTestApplication : public ns3::Application {
 public:
     CryptoTestApplication();
@@ -19,11 +23,17 @@ public:
                uint32_t packetSize, EnhancedMEMOSTPProtocol* protocol, 
                bool isReceiver, uint32_t nodeId);
     
+    // Hold outgoing packets outside the scheduler's rendezvous interval,
+    // when this radio or one on the path may be asleep, and send them at
+    // the start of the next one.
+    void SetDutyCycle(DutyCycleScheduler* scheduler) { m_dutyCycle = scheduler; }
+    
     void StartApplication() override;
     void StopApplication() override;
     
 private:
     void SendPacket();
+    void FlushPending();
     void HandleRead(ns3::Ptr<ns3::Socket> socket);
     
     ns3::Ptr<ns3::Socket> m_socket;
@@ -35,6 +45,11 @@ private:
     uint32_t m_nodeId;
     uint32_t m_packetCounter;
     ns3::EventId m_sendEvent;
+    RngStream m_payload;   // per-node stream for packet contents
+    
+    DutyCycleScheduler* m_dutyCycle;
+    std::deque<std::pair<ns3::Ptr<ns3::Packet>, double>> m_pending; // (packet, queued at)
+    ns3::EventId m_flushEvent;
 };
 
 #endif // CRYPTO_APP_H
\ No newline at end of file
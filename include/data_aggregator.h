@@ -0,0 +1,57 @@
+#ifndef DATA_AGGREGATOR_H
+#define DATA_AGGREGATOR_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// Combines sensor readings into one frame per aggregation window so a
+// forwarder sends and encrypts once instead of once per reading.
+//
+// Frame layout (little-endian, before encryption):
+//   u8 function, u32 readings, f64 mean sample time, then
+//   Min/Max/Mean: f64 value
+//   Count:        nothing
+//   Concat:       u16 n, n x (u32 source, f64 value)
+// Concat frames hold at most concatCap readings; IsFull() tells the caller
+// to flush early.
+class DataAggregator {
+public:
+    enum class Function : uint8_t { Min = 0, Max, Mean, Count, Concat };
+
+    struct Frame {
+        Function function;
+        uint32_t readings;
+        double meanTime;
+        double value;                                       // Min/Max/Mean
+        std::vector<std::pair<uint32_t, double>> samples;   // Concat
+    };
+
+    explicit DataAggregator(Function function = Function::Mean, uint32_t concatCap = 32);
+
+    void Add(uint32_t source, double time, double value);
+    bool IsEmpty() const { return readings == 0; }
+    bool IsFull() const;
+    uint32_t GetReadingCount() const { return readings; }
+
+    // Appends the frame for the buffered readings to out and resets the
+    // window. Returns the number of readings it covers.
+    uint32_t Flush(std::vector<uint8_t>& out);
+    static bool Decode(const std::vector<uint8_t>& in, size_t pos, Frame& frame);
+
+    static bool ParseFunction(const std::string& name, Function& function);
+    static const char* FunctionName(Function function);
+
+private:
+    Function function;
+    uint32_t concatCap;
+
+    uint32_t readings;
+    double timeSum;
+    double valueSum;
+    double minValue;
+    double maxValue;
+    std::vector<std::pair<uint32_t, double>> samples;
+};
+
+#endif // DATA_AGGREGATOR_H
@@ -0,0 +1,44 @@
+#ifndef DEATH_TRACKER_H
+#define DEATH_TRACKER_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "node_monitor.h"
+#include "energy_model_helper.h"
+#include <vector>
+
+// Event-driven death detection, shared by the main simulation and the
+// optimizer's sub-simulations. EnergyModelHelper sets each node's
+// BasicEnergySource low-battery threshold to NodeMonitor::kDeathThreshold,
+// and the source's depletion notification records the death; nothing is
+// scheduled per energy update. The RemainingEnergy trace only keeps the
+// monitor's residual energy current (the cluster election and the online
+// optimizer read it) and remembers where the threshold was crossed, so the
+// death is timestamped by interpolating within that update interval.
+//
+// A dead node's applications are stopped, so it neither sends nor serves
+// as a cluster head from then on.
+class DeathTracker : public ns3::Object {
+public:
+    DeathTracker(ns3::NodeContainer& nodes, NodeMonitor& monitor, EnergyModelHelper& energy);
+
+    // Called with the node id after each recorded death.
+    void SetDeathCallback(ns3::Callback<void, uint32_t> callback) { m_onDeath = callback; }
+
+    void Start();
+
+private:
+    static void OnRemainingEnergy(DeathTracker* tracker, uint32_t nodeId,
+                                  double oldValue, double newValue);
+    void EnergyChanged(uint32_t nodeId, double oldValue, double newValue);
+    void Depleted(uint32_t nodeId);
+
+    ns3::NodeContainer& m_nodes;
+    NodeMonitor& m_monitor;
+    EnergyModelHelper& m_energy;
+    std::vector<double> m_lastUpdate;
+    std::vector<double> m_crossing;
+    ns3::Callback<void, uint32_t> m_onDeath;
+};
+
+#endif // DEATH_TRACKER_H
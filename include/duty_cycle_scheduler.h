@@ -0,0 +1,77 @@
+#ifndef DUTY_CYCLE_SCHEDULER_H
+#define DUTY_CYCLE_SCHEDULER_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include <string>
+#include <vector>
+
+class EnergyModelHelper;
+
+// Periodic radio duty cycling. Every node is awake for
+// period * (1 - sleepRatio) at the start of each of its periods and puts its
+// WifiPhy to sleep for the rest. Synchronized mode wakes all nodes together;
+// staggered mode spreads the wake-ups over the first half of the shortest
+// awake window, so wake-ups do not all contend at once yet every window
+// still overlaps a common rendezvous interval. Applications send in that
+// interval, when the next hop and every relay after it are awake too.
+class DutyCycleScheduler {
+public:
+    enum class WakeMode { Synchronized, Staggered };
+
+    DutyCycleScheduler();
+
+    void Configure(ns3::NetDeviceContainer& devices, double period, double sleepRatio, WakeMode mode);
+    void Start(double startTime);
+    bool IsEnabled() const { return m_period > 0.0 && m_sleepRatio > 0.0; }
+    // Takes effect at each node's next wake-up; the period stays, so
+    // windows remain on the period grid
+    void SetSleepRatio(double sleepRatio);
+    // Per-node ratios; GetSleepRatio() then returns their mean
+    void SetSleepRatio(const std::vector<double>& sleepRatio);
+    double GetSleepRatio() const { return m_sleepRatio; }
+
+    bool IsAwake(uint32_t nodeId) const;
+    double TimeUntilWake(uint32_t nodeId) const;
+    // 0 while every radio is in its wake window, else the time until all are
+    double TimeUntilRendezvous() const;
+
+    // Applications report how long a packet was held back for the radio.
+    void RecordDeferral(uint32_t nodeId, double delay);
+
+    static bool ParseWakeMode(const std::string& name, WakeMode& mode);
+
+    uint32_t GetDeferredPackets() const { return m_deferredPackets; }
+    double GetAverageAddedLatency() const;
+    double GetSleepTime(const EnergyModelHelper& energy) const;
+    // Energy not spent because radios slept instead of idling.
+    double GetEnergySaved(const EnergyModelHelper& energy) const;
+
+    void PrintReport(const EnergyModelHelper* energy) const;
+
+private:
+    void Wake(uint32_t nodeId);
+    void Sleep(uint32_t nodeId);
+    double Offset(uint32_t nodeId) const;
+    void UpdateWindows();
+    double AwakeTime(uint32_t nodeId) const {
+        return nodeId < m_nodeAwake.size() ? m_nodeAwake[nodeId] : m_awake;
+    }
+
+    ns3::NetDeviceContainer m_devices;
+    double m_period;
+    double m_sleepRatio;
+    double m_awake;
+    std::vector<double> m_nodeAwake;   // empty = m_awake for every node
+    WakeMode m_mode;
+    double m_stagger;                  // wake-ups spread over [0, m_stagger)
+    double m_rendezvousStart;          // phase range in which all are awake
+    double m_rendezvousEnd;
+    double m_startTime;
+
+    uint32_t m_deferredPackets;
+    double m_totalDeferral;
+    double m_maxDeferral;
+};
+
+#endif // DUTY_CYCLE_SCHEDULER_H
@@ -0,0 +1,76 @@
+#ifndef ENERGY_MODEL_HELPER_H
+#define ENERGY_MODEL_HELPER_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-phy-state.h"
+#include <array>
+#include <string>
+#include <vector>
+
+// Radio currents (A) and supply voltage (V) of a transceiver.
+struct RadioHardwareProfile {
+    std::string name;
+    double supplyVoltage;
+    double txCurrent;
+    double rxCurrent;
+    double idleCurrent;
+    double ccaBusyCurrent;
+    double switchingCurrent;
+    double sleepCurrent;
+
+    // Built-in profiles: "wifi" (ns-3 802.11 defaults), "esp32", "cc2420".
+    static bool Lookup(const std::string& name, RadioHardwareProfile& profile);
+    static std::string Names();
+};
+
+// Installs a BasicEnergySource and a WifiRadioEnergyModel per node, so
+// energy drains with actual radio activity, and keeps a per-node breakdown
+// of time and energy spent in each PHY state.
+class EnergyModelHelper {
+public:
+    enum RadioState { Idle = 0, CcaBusy, Tx, Rx, Switching, Sleep, Off, StateCount };
+
+    explicit EnergyModelHelper(const RadioHardwareProfile& profile);
+
+    // cutoffEnergy is the level at which the source reports depletion and
+    // the radio is switched off.
+    void InstallEnergyModel(ns3::NodeContainer& nodes, ns3::NetDeviceContainer& devices,
+                            double initialEnergy, double cutoffEnergy);
+
+    static double GetRemainingEnergy(ns3::NodeContainer& nodes, uint32_t nodeId);
+
+    // Called with the node id when its source reaches the cutoff, after the
+    // radio has been switched off
+    void SetDepletionCallback(ns3::Callback<void, uint32_t> callback) { m_onDepleted = callback; }
+
+    // Closes the open state interval of every radio at the current time;
+    // call once after Simulator::Run().
+    void Finalize();
+
+    double GetStateTime(uint32_t nodeId, RadioState state) const;
+    double GetStateEnergy(uint32_t nodeId, RadioState state) const;
+    double GetTotalStateEnergy(RadioState state) const;
+    const RadioHardwareProfile& GetProfile() const { return m_profile; }
+
+    static const char* StateName(RadioState state);
+
+    void PrintEnergyBreakdown() const;
+    void ExportEnergyBreakdown(const std::string& filename) const;
+
+private:
+    static void OnStateLogged(EnergyModelHelper* helper, uint32_t nodeId,
+                              ns3::Time start, ns3::Time duration, ns3::WifiPhyState state);
+    static void OnDepleted(EnergyModelHelper* helper, uint32_t nodeId);
+    void AddStateTime(uint32_t nodeId, RadioState state, double seconds);
+    double StateCurrent(RadioState state) const;
+    static RadioState FromPhyState(ns3::WifiPhyState state);
+
+    RadioHardwareProfile m_profile;
+    ns3::NetDeviceContainer m_devices;
+    std::vector<std::array<double, StateCount>> m_stateTime;
+    std::vector<double> m_lastLogged;
+    ns3::Callback<void, uint32_t> m_onDepleted;
+};
+
+#endif // ENERGY_MODEL_HELPER_H
@@ -11,8 +11,19 @@
 #include <ctime>
 #include <sstream>
 
+class TelemetrySink;
+class EventLogWriter;
+
 class EventEmitter {
 public:
+    // How events are stamped. SimTime writes only the simulator clock; the
+    // wall-clock variant adds a cached, coarse "timestamp" (ms since epoch)
+    // that is refreshed every N events, for profiling the simulator itself.
+    enum class TimestampMode {
+        SimTime,
+        SimTimeWithWallClock
+    };
+    
     static EventEmitter& Instance() {
         static EventEmitter instance;
         return instance;
@@ -21,8 +32,26 @@ public:
     void EmitEvent(const std::string& event, uint32_t packetId, int from = -1, int to = -1);
     void EmitNodeEvent(uint32_t nodeId, const std::string& status, double energy = -1.0);
     void EmitMetric(const std::string& metric, double value, const std::string& unit = "");
+    void EmitFrame(uint64_t frameId, const std::string& nodesJson, size_t changedNodes);
+    
+    // Forward an already-formatted event line (e.g. from a recorded run)
+    // over the same channels as live events.
+    void PublishRaw(const std::string& line, double simTime);
     
     void SetSimulationStartTime();
+    void SetTimestampMode(TimestampMode mode, uint32_t wallClockRefreshEvents = 64);
+    TimestampMode GetTimestampMode() const { return timestampMode; }
+    double GetSimulationStartTime() const { return simulationStartTime; }
+    
+    // Mirror every event line into a telemetry sink (shared memory). With
+    // keepStdout=false the JSON lines no longer go to stdout; detaching the
+    // sink (nullptr) always restores stdout output.
+    void AttachTelemetrySink(TelemetrySink* sink, bool keepStdout);
+    TelemetrySink* GetTelemetrySink() const { return telemetrySink; }
+    
+    // Additionally record every event line into a block-compressed log.
+    void AttachEventLog(EventLogWriter* log);
+    
     void LogNodeDeath(uint32_t nodeId, double deathTime, const std::string& cause);
     
     double GetFirstNodeDeathTime() const { return firstNodeDeathTime; }
@@ -32,16 +61,35 @@ public:
     void PrintDeathStatistics() const;
     
 private:
-    EventEmitter() : simulationStartTime(0.0), firstNodeDeathTime(-1.0), lastNodeDeathTime(-1.0) {}
+    EventEmitter() : simulationStartTime(0.0), firstNodeDeathTime(-1.0), lastNodeDeathTime(-1.0),
+                     timestampMode(TimestampMode::SimTime), wallClockRefreshEvents(64),
+                     eventsSinceWallClockRefresh(0), cachedWallClockMs(0),
+                     telemetrySink(nullptr), eventLog(nullptr), stdoutEnabled(true) {}
     EventEmitter(const EventEmitter&) = delete;
     EventEmitter& operator=(const EventEmitter&) = delete;
     
+    void WriteTimeFields(std::ostream& os);
+    std::ostringstream& BeginLine();
+    void PublishLine();
+    
     double simulationStartTime;
     double firstNodeDeathTime;
     double lastNodeDeathTime;
     std::vector<std::pair<uint32_t, double>> nodeDeaths;
     std::map<std::string, std::vector<double>> metrics;
-    mutable std::mutex mtx;
+    
+    TimestampMode timestampMode;
+    uint32_t wallClockRefreshEvents;
+    uint32_t eventsSinceWallClockRefresh;
+    int64_t cachedWallClockMs;
+    
+    TelemetrySink* telemetrySink;
+    EventLogWriter* eventLog;
+    bool stdoutEnabled;
+    std::ostringstream lineBuffer;
+    
+    // Recursive: LogNodeDeath emits the node/death events while holding the lock.
+    mutable std::recursive_mutex mtx;
 };
 
-#endif // EVENT_EMITTER_H
\ No newline at end of file
+#endif // EVENT_EMITTER_H
@@ -0,0 +1,105 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+// Block-compressed, seekable event log.
+//
+// <path>        "WSNEVLG1" file header, then a sequence of blocks. Each block
+//               is an EventLogBlockHeader followed by compressedSize bytes of
+//               LzCodec output (or rawSize stored bytes when compression did
+//               not help). A decompressed block is plain JSON lines.
+// <path>.idx    "WSNEVIX1" header, then one EventLogIndexEntry per block,
+//               appended as blocks are written. Maps simulation time ranges
+//               to file offsets so a reader can seek without touching the
+//               prefix. If it is missing, the reader rebuilds it by walking
+//               the block headers.
+struct EventLogBlockHeader {
+    uint32_t magic;            // 'BLK1'
+    uint32_t flags;            // bit 0: payload stored uncompressed
+    uint32_t rawSize;
+    uint32_t compressedSize;
+    uint32_t eventCount;
+    uint32_t checksum;         // FNV-1a of the raw payload
+    double firstTime;
+    double lastTime;
+};
+
+struct EventLogIndexEntry {
+    double firstTime;
+    double lastTime;
+    uint64_t offset;           // of the block header in the log file
+    uint32_t compressedSize;
+    uint32_t rawSize;
+    uint32_t eventCount;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(EventLogBlockHeader) == 40, "EventLogBlockHeader layout changed");
+static_assert(sizeof(EventLogIndexEntry) == 40, "EventLogIndexEntry layout changed");
+
+// Reads the leading "time" field of an emitted JSON event line.
+bool ExtractEventTime(const std::string& line, double& time);
+
+class EventLogWriter {
+public:
+    EventLogWriter();
+    ~EventLogWriter();
+
+    bool Open(const std::string& path, size_t blockSize = 64 * 1024);
+    void Append(const std::string& line, double simTime);
+    void Close();
+    bool IsOpen() const { return log.is_open(); }
+
+    uint64_t GetRawBytes() const { return rawBytes; }
+    uint64_t GetCompressedBytes() const { return compressedBytes; }
+
+private:
+    void FlushBlock();
+
+    std::ofstream log;
+    std::ofstream index;
+    size_t blockSize;
+    std::string block;
+    std::vector<uint8_t> scratch;
+    uint32_t blockEvents;
+    double blockFirstTime;
+    double blockLastTime;
+    uint64_t offset;
+    uint64_t rawBytes;
+    uint64_t compressedBytes;
+};
+
+// Streams events back block by block; memory use is one block.
+class EventLogReader {
+public:
+    bool Open(const std::string& path);
+
+    // Position at the first event with time >= t, decompressing only the
+    // block that contains it.
+    bool Seek(double t);
+    bool Next(std::string& line, double& time);
+
+    const std::vector<EventLogIndexEntry>& GetIndex() const { return index; }
+    double GetStartTime() const { return index.empty() ? 0.0 : index.front().firstTime; }
+    double GetEndTime() const { return index.empty() ? 0.0 : index.back().lastTime; }
+
+private:
+    bool LoadIndex(const std::string& indexPath);
+    bool RebuildIndex();
+    bool LoadBlock(size_t blockIndex);
+
+    std::ifstream log;
+    std::vector<EventLogIndexEntry> index;
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> raw;
+    size_t nextBlock = 0;
+    size_t cursor = 0;
+    bool blockLoaded = false;
+    double seekTime = -1.0;
+};
+
+#endif // EVENT_LOG_H
@@ -0,0 +1,73 @@
+#ifndef FITNESS_CACHE_H
+#define FITNESS_CACHE_H
+
+#include "fitness_evaluator.h"
+#include <unordered_map>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Memoizes evaluations. Parameter vectors are quantized (default 1e-3 per
+// parameter) and hashed together with a context hash that identifies what
+// was evaluated (scenario, sub-simulation length, scoring), so entries for
+// different deployments share a file without colliding.
+//
+// <path>  "WSNFCAC1" header, then records appended as evaluations finish:
+//         FitnessCacheRecord followed by valueCount doubles. A torn record
+//         at the tail (crash mid-write) is ignored on load.
+//
+// As a FitnessEvaluator it stores one value (the fitness) per key and
+// sends only the misses of each batch on to the wrapped evaluator. Callers
+// that keep richer results use Lookup/Insert under their own context hash.
+struct FitnessCacheRecord {
+    uint64_t key;
+    uint32_t valueCount;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(FitnessCacheRecord) == 16, "FitnessCacheRecord layout changed");
+
+class FitnessCache : public FitnessEvaluator {
+public:
+    FitnessCache(FitnessEvaluator* evaluator, uint64_t context, double step = 1e-3);
+    ~FitnessCache() override;
+
+    // Loads earlier entries and appends new ones to the file. Without a
+    // file the cache is in-memory only.
+    bool Open(const std::string& path);
+    void Close();
+
+    void Evaluate(const std::vector<std::vector<double>>& candidates,
+                  std::vector<double>& fitness) override;
+    std::string GetName() const override;
+
+    bool Lookup(uint64_t contextHash, const std::vector<double>& params, std::vector<double>& values);
+    void Insert(uint64_t contextHash, const std::vector<double>& params, const std::vector<double>& values);
+
+    uint64_t GetLookups() const { return lookups; }
+    uint64_t GetHits() const { return hits; }
+    double GetHitRate() const { return lookups > 0 ? (double)hits / lookups * 100.0 : 0.0; }
+    size_t GetEntryCount() const { return entries.size(); }
+
+    void PrintReport() const;
+
+    // 64-bit FNV-1a, chainable through seed
+    static uint64_t Hash(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ULL);
+
+private:
+    uint64_t Key(uint64_t contextHash, const std::vector<double>& params) const;
+
+    FitnessEvaluator* inner;
+    uint64_t contextHash;
+    double quantum;
+
+    std::unordered_map<uint64_t, std::vector<double>> entries;
+    std::ofstream file;
+    std::string path;
+    size_t loadedEntries;
+    uint64_t lookups;
+    uint64_t hits;
+};
+
+#endif // FITNESS_CACHE_H
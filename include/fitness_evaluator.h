@@ -0,0 +1,20 @@
+#ifndef FITNESS_EVALUATOR_H
+#define FITNESS_EVALUATOR_H
+
+#include <vector>
+#include <string>
+
+// Scores batches of optimizer candidates (energy weight, power control,
+// sleep ratio). Higher is better. Batches let an implementation spread the
+// candidates over whatever parallelism it has.
+class FitnessEvaluator {
+public:
+    virtual ~FitnessEvaluator() = default;
+
+    // fitness is resized to candidates.size()
+    virtual void Evaluate(const std::vector<std::vector<double>>& candidates,
+                          std::vector<double>& fitness) = 0;
+    virtual std::string GetName() const = 0;
+};
+
+#endif // FITNESS_EVALUATOR_H
@@ -0,0 +1,64 @@
+#ifndef FRAME_EMITTER_H
+#define FRAME_EMITTER_H
+
+#include "ns3/simulator.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// Coalesces per-node state changes (energy, status) that happen within one
+// simulation-time tick and emits them as a single delta-encoded "frame"
+// event containing only the nodes that changed since the previous frame.
+class FrameEmitter {
+public:
+    static FrameEmitter& Instance() {
+        static FrameEmitter instance;
+        return instance;
+    }
+    
+    // tickSeconds <= 0 disables framing (callers fall back to per-event output);
+    // updates are still mirrored into the telemetry node table.
+    // Energy changes smaller than energyResolution (J) are not re-sent.
+    void Configure(uint32_t nodeCount, double tickSeconds, double energyResolution = 0.001);
+    void Start();
+    void Stop();
+    
+    bool IsEnabled() const { return tickInterval > 0.0; }
+    
+    void UpdateEnergy(uint32_t nodeId, double energy);
+    void UpdateStatus(uint32_t nodeId, const std::string& status);
+    
+    // Emit pending changes immediately (e.g. after Simulator::Run returns).
+    void Flush();
+    
+    uint64_t GetFramesEmitted() const { return framesEmitted; }
+    uint64_t GetUpdatesCoalesced() const { return updatesReceived; }
+    
+private:
+    FrameEmitter() : tickInterval(0.0), energyResolution(0.001),
+                     framesEmitted(0), updatesReceived(0) {}
+    FrameEmitter(const FrameEmitter&) = delete;
+    FrameEmitter& operator=(const FrameEmitter&) = delete;
+    
+    struct NodeFrameState {
+        double energy;
+        double sentEnergy;
+        std::string status;
+        std::string sentStatus;
+        bool dirty;
+    };
+    
+    void Tick();
+    void MarkDirty(uint32_t nodeId);
+    void MirrorToTelemetry(uint32_t nodeId);
+    
+    std::vector<NodeFrameState> nodes;
+    std::vector<uint32_t> dirtyNodes;
+    double tickInterval;
+    double energyResolution;
+    uint64_t framesEmitted;
+    uint64_t updatesReceived;
+    ns3::EventId tickEvent;
+};
+
+#endif // FRAME_EMITTER_H
@@ -0,0 +1,60 @@
+#ifndef GAUSSIAN_PROCESS_H
+#define GAUSSIAN_PROCESS_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// Gaussian-process regression with a squared-exponential kernel and one
+// length scale per input (ARD). Inputs are expected in [0, 1]; targets are
+// standardized internally, so the signal variance is fixed at 1 and only
+// the length scales and the noise variance are fitted, by maximizing the
+// log marginal likelihood over quasi-random settings. The Cholesky factor
+// is kept, so each prediction costs O(n^2) and predictions may run
+// concurrently.
+class GaussianProcess {
+public:
+    GaussianProcess();
+
+    // Replaces the data and sets the target standardization from it
+    bool SetData(const std::vector<std::vector<double>>& x, const std::vector<double>& y);
+    // Appends a point under the current standardization and hyperparameters
+    bool AddObservation(const std::vector<double>& x, double y);
+
+    // Tries `trials` settings of log length scale (0.03-3) and log noise
+    // (1e-6-0.3) and keeps the most likely; returns false if none factorized
+    bool FitHyperparameters(uint32_t trials);
+
+    // Posterior mean and standard deviation of the latent function, in
+    // target units
+    void Predict(const std::vector<double>& x, double& mean, double& stddev) const;
+
+    // Expected amount by which f(x) exceeds `best` (maximization)
+    double ExpectedImprovement(const std::vector<double>& x, double best) const;
+
+    size_t GetSize() const { return inputs.size(); }
+    const std::vector<double>& GetLengthScales() const { return lengthScales; }
+    double GetNoise() const { return noise; }
+    double GetLogLikelihood() const { return logLikelihood; }
+
+private:
+    double Kernel(const std::vector<double>& a, const std::vector<double>& b,
+                  const std::vector<double>& scales) const;
+    // Factorizes K + noise I for the given hyperparameters into the
+    // arguments; returns the log marginal likelihood, or -inf
+    double Factorize(const std::vector<double>& scales, double noiseVariance,
+                     std::vector<double>& factor, std::vector<double>& weights) const;
+
+    std::vector<std::vector<double>> inputs;
+    std::vector<double> targets;           // standardized
+    double targetMean;
+    double targetScale;
+
+    std::vector<double> lengthScales;
+    double noise;
+    double logLikelihood;
+    std::vector<double> cholesky;          // lower triangle, row-major n x n
+    std::vector<double> alpha;             // (K + noise I)^-1 targets
+};
+
+#endif // GAUSSIAN_PROCESS_H
@@ -0,0 +1,23 @@
+#ifndef LZ_CODEC_H
+#define LZ_CODEC_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Small in-tree LZ77 codec producing the LZ4 block format (token, literals,
+// 16-bit offset, match length; last 5 bytes always literals). Fast enough to
+// compress the event stream inline and needs no external dependency.
+class LzCodec {
+public:
+    // Worst-case compressed size for an input of n bytes.
+    static size_t MaxCompressedSize(size_t n) { return n + n / 255 + 16; }
+
+    // Appends the compressed form of [src, src+n) to out; returns bytes added.
+    static size_t Compress(const uint8_t* src, size_t n, std::vector<uint8_t>& out);
+
+    // Decodes exactly rawSize bytes into out. Returns false on malformed input.
+    static bool Decompress(const uint8_t* src, size_t n, size_t rawSize, std::vector<uint8_t>& out);
+};
+
+#endif // LZ_CODEC_H
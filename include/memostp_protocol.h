@@ -5,6 +5,8 @@
 #include "ns3/network-module.h"
 #include "ascon_crypto.h"
 #include "snake_optimizer.h"
+#include "fitness_evaluator.h"
+#include "parameter_matrix.h"
 #include <vector>
 #include <random>
 
@@ -13,6 +15,9 @@ private:
     ns3::NodeContainer nodes;
     EnhancedSnakeOptimizer optimizer;
     std::vector<double> optimizedParams;
+    ParameterMatrix nodeParams;
+    bool parametersPreset;
+    bool resumeOptimization;
     int optimization_iterations;
     AsconCrypto cryptoEngine;
     bool cryptoEnabled;
@@ -27,6 +32,34 @@ public:
     
     void initializeProtocol();
     
+    // Snake population and fitness threads (0 = all cores)
+    void configureOptimizer(uint32_t populationSize, uint32_t threads);
+    void setFitnessEvaluator(FitnessEvaluator* evaluator) { optimizer.setFitnessEvaluator(evaluator); }
+    
+    // Checkpoint the optimization in initializeProtocol() to `path` every
+    // `every` iterations; with resume set, continue from it if it matches
+    void configureCheckpoint(const std::string& path, uint64_t context, uint32_t every, bool resume);
+    
+    // Rings around the sink that get their own parameters; 1 = global
+    void configureRegions(uint32_t regions, ColumnView<double> x, ColumnView<double> y, uint32_t sinkNode);
+    uint32_t getRegionCount() const { return nodeParams.GetRegionCount(); }
+    size_t getParameterCount() const { return optimizer.getDimensions(); }
+    
+    // Use these parameters (e.g. a Pareto operating point) instead of
+    // running the Snake Optimizer in initializeProtocol()
+    void setParameters(const std::vector<double>& params);
+    
+    // Warm-started re-optimization while the simulation runs, in slices of
+    // at most `budget` fitness evaluations; continueReoptimization() returns
+    // true once the run has finished and its parameters are in effect.
+    // setNetworkState() gives the model fitness the live alive mask and
+    // residual energies before a run.
+    void setNetworkState(ColumnView<uint8_t> alive, ColumnView<double> remaining, ColumnView<double> initial);
+    void beginReoptimization(int iterations);
+    bool continueReoptimization(uint32_t budget);
+    bool isReoptimizing() const { return optimizer.isRunning(); }
+    uint64_t getOptimizerEvaluations() const { return optimizer.getEvaluationCount(); }
+    
     std::vector<uint8_t> encryptPacket(const std::vector<uint8_t>& plaintext, 
                                       uint32_t nodeId, uint32_t packetId);
     std::vector<uint8_t> decryptPacket(const std::vector<uint8_t>& ciphertext, 
@@ -36,6 +69,9 @@ public:
     double getPowerControl() const;
     double getSleepRatio() const;
     
+    // Per-node rows; the scalar getters above return network means
+    const ParameterMatrix& getNodeParameters() const { return nodeParams; }
+    
     uint32_t getPacketsEncrypted() const { return packetsEncrypted; }
     uint32_t getPacketsDecrypted() const { return packetsDecrypted; }
     uint32_t getPacketsReceived() const { return packetsReceived; }
@@ -48,6 +84,7 @@ public:
 
 private:
     void generateCryptoKeys();
+    void applyParameters(const std::vector<double>& params);
 };
 
 #endif // MEMOSTP_PROTOCOL_H
\ No newline at end of file
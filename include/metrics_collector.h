@@ -17,6 +17,7 @@ public:
         uint32_t totalTxPackets;
         uint32_t totalRxPackets;
         uint32_t totalLostPackets;
+        uint64_t totalRxBytes;
         
         // Performance metrics
         double packetDeliveryRatio;
@@ -28,6 +29,12 @@ public:
         double totalEnergyConsumed;
         double energyEfficiency;
         double energyPerNode;
+        double energyPerBit;             // J per delivered bit
+        uint64_t readingsDelivered;
+        double energyPerReading;         // J of reading-traffic energy per delivered reading
+        double cryptoOpsPerReading;
+        double dutyCycleEnergySaved;
+        double dutyCycleAddedLatency;
         
         // Network lifetime metrics
         double networkLifetime;
@@ -36,11 +43,16 @@ public:
         double averageNodeLifetime;
         uint32_t aliveNodeCount;
         double networkCoverage;
+        double kCoverage;
+        uint32_t coverageK;
         
         // Survivability metrics
         double networkSurvivabilityIndex;
         double nodeSurvivalRate;
-        double connectivityRatio;
+        double connectivityRatio;        // % of nodes with a live path to the sink
+        double largestComponentRatio;
+        uint32_t componentCount;
+        double partitionTime;            // -1 if the network never split
         
         // QoS metrics
         double packetLossRate;
@@ -58,6 +70,12 @@ public:
     void CollectFlowMetrics(ns3::Ptr<ns3::FlowMonitor> monitor);
     void UpdateEnergyMetrics(double energyConsumed, uint32_t nodeCount);
     void UpdateNodeDeathMetrics(double deathTime, uint32_t nodeId, uint32_t totalNodes);
+    // readingEnergy: network energy less what non-reading traffic spent
+    void UpdateReadingMetrics(uint64_t readingsDelivered, double readingEnergy, uint64_t cryptoOperations);
+    void UpdateDutyCycleMetrics(double energySaved, double addedLatency);
+    void UpdateCoverageMetrics(double coverage, double kCoverage, uint32_t k);
+    void UpdateConnectivityMetrics(double sinkReachable, double largestComponent,
+                                   uint32_t components, double partitionTime);
     void UpdateCryptoMetrics(uint32_t encrypted, uint32_t decrypted);
     void CalculateJitterMetrics(const std::vector<double>& jitterSamples);
     
@@ -70,6 +88,9 @@ private:
     std::vector<double> delaySamples;
     std::vector<double> jitterSamples;
     std::vector<double> nodeDeathTimes;
+    bool coverageMeasured;
+    bool connectivityMeasured;
+    bool dutyCycled;
     
     void CalculateDerivedMetrics(uint32_t totalNodes);
     double CalculateSurvivabilityIndex() const;
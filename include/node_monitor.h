@@ -6,9 +6,40 @@
 #include <string>
 #include <iostream>
 #include <iomanip>
+#include <cstdint>
+
+class CoverageEngine;
+class ConnectivityTracker;
+
+// Read-only view over one NodeMonitor column.
+template <typename T>
+class ColumnView {
+public:
+    ColumnView(const T* data, size_t size) : m_data(data), m_size(size) {}
+
+    const T* begin() const { return m_data; }
+    const T* end() const { return m_data + m_size; }
+    const T* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    const T& operator[](size_t i) const { return m_data[i]; }
+
+private:
+    const T* m_data;
+    size_t m_size;
+};
+
+// Built-in death causes; further causes are interned on first use and get
+// ids after these. The label table is shared by all monitors.
+enum class DeathCause : uint8_t {
+    None = 0,
+    EnergyDepletion,
+    SimulatedFailure,
+    Unknown
+};
 
 class NodeMonitor {
 public:
+    // Row snapshot of a single node, assembled from the columns.
     struct NodeStatus {
         uint32_t nodeId;
         double initialEnergy;
@@ -24,40 +55,103 @@ public:
         double positionX;
         double positionY;
     };
-    
+
+    // Residual energy (J) at or below which a node counts as dead
+    static constexpr double kDeathThreshold = 0.05;
+
     NodeMonitor();
-    
+
     void InitializeNodes(uint32_t nodeCount, double initialEnergy);
     void UpdateEnergy(uint32_t nodeId, double energyConsumed);
+    void SetRemainingEnergy(uint32_t nodeId, double remainingEnergy);
     void UpdatePacketCount(uint32_t nodeId, bool isSent);
-    void CheckNodeDeath(uint32_t nodeId, double currentTime, const std::string& cause = "Energy Depletion");
+    void CheckNodeDeath(uint32_t nodeId, double currentTime, DeathCause cause = DeathCause::EnergyDepletion);
+    void CheckNodeDeath(uint32_t nodeId, double currentTime, const std::string& cause);
     void RecordJitter(uint32_t nodeId, double jitter);
     void UpdatePosition(uint32_t nodeId, double x, double y);
     
+    // Geometric coverage from node positions; deaths are removed from the
+    // engine as they are recorded. Without an engine, coverage falls back to
+    // the alive fraction.
+    void AttachCoverageEngine(CoverageEngine* engine) { coverageEngine = engine; }
+    void AttachConnectivityTracker(ConnectivityTracker* tracker) { connectivityTracker = tracker; }
+
     NodeStatus GetNodeStatus(uint32_t nodeId) const;
-    std::vector<NodeStatus> GetAllNodeStatus() const;
-    
+    uint32_t GetNodeCount() const { return totalNodes; }
+
+    // Column views; valid until the next InitializeNodes().
+    ColumnView<double> RemainingEnergyColumn() const { return View(remainingEnergy); }
+    ColumnView<double> InitialEnergyColumn() const { return View(initialEnergy); }
+    ColumnView<uint8_t> AliveColumn() const { return View(alive); }
+    ColumnView<double> DeathTimeColumn() const { return View(deathTime); }
+    ColumnView<uint8_t> DeathCauseColumn() const { return View(deathCause); }
+    ColumnView<uint32_t> PacketsSentColumn() const { return View(packetsSent); }
+    ColumnView<uint32_t> PacketsReceivedColumn() const { return View(packetsReceived); }
+    ColumnView<double> PositionXColumn() const { return View(positionX); }
+    ColumnView<double> PositionYColumn() const { return View(positionY); }
+
+    static uint8_t InternDeathCause(const std::string& label);
+    static const std::string& DeathCauseLabel(uint8_t cause);
+
     bool IsNodeAlive(uint32_t nodeId) const;
     double GetNodeRemainingEnergy(uint32_t nodeId) const;
-    
+
     double GetNetworkLifetime() const;
     double GetAverageNodeLifetime() const;
     uint32_t GetAliveNodeCount() const;
     double GetNetworkCoverage() const;
+    double GetKCoverage() const;
     double GetFirstNodeDeathTime() const;
     double GetLastNodeDeathTime() const;
     
+    // Time at which at least ceil(fraction * N) nodes were dead, or -1 if the
+    // run has not got there. FND/HND/LND are fraction 1/N, 0.5 and 1.0.
+    double GetTimeUntilDeadFraction(double fraction) const;
+    double GetHalfNodesDeadTime() const { return GetTimeUntilDeadFraction(0.5); }
+    double GetAllNodesDeadTime() const { return GetTimeUntilDeadFraction(1.0); }
+    
+    // (deathTime, nodeId), ordered by time.
+    const std::vector<std::pair<double, uint32_t>>& GetDeathTimeline() const { return deathTimeline; }
+
     void PrintNodeStatusTable() const;
     void PrintNetworkLifetimeMetrics() const;
     void ExportNodeData(const std::string& filename) const;
-    
+
 private:
-    std::vector<NodeStatus> nodeStatuses;
+    template <typename T>
+    static ColumnView<T> View(const std::vector<T>& column) {
+        return ColumnView<T>(column.data(), column.size());
+    }
+
+    // Hot columns (touched by the periodic scans and per-packet updates)
+    std::vector<double> remainingEnergy;
+    std::vector<uint8_t> alive;
+    std::vector<uint32_t> packetsSent;
+    std::vector<uint32_t> packetsReceived;
+
+    // Cold columns
+    std::vector<double> initialEnergy;
+    std::vector<double> deathTime;
+    std::vector<uint8_t> deathCause;
+    std::vector<double> lastActivityTime;
+    std::vector<double> jitterSum;
+    std::vector<uint32_t> jitterCount;
+    std::vector<double> positionX;
+    std::vector<double> positionY;
+
+    // Lifetime aggregates, maintained as deaths are recorded
+    uint32_t aliveCount;
+    double deathTimeSum;
+    uint32_t timedDeathCount;
+    std::vector<std::pair<double, uint32_t>> deathTimeline;
+    
     double networkStartTime;
     uint32_t totalNodes;
     double areaSize;
-    
+    CoverageEngine* coverageEngine;
+    ConnectivityTracker* connectivityTracker;
+
     double calculateCoverage() const;
 };
 
-#endif // NODE_MONITOR_H
\ No newline at end of file
+#endif // NODE_MONITOR_H
@@ -0,0 +1,64 @@
+#ifndef ONLINE_OPTIMIZER_H
+#define ONLINE_OPTIMIZER_H
+
+#include "ns3/core-module.h"
+#include "node_monitor.h"
+#include <cstdint>
+
+class EnhancedMEMOSTPProtocol;
+class TxPowerController;
+class DutyCycleScheduler;
+class ClusterManager;
+
+// Re-optimizes the protocol parameters while the simulation runs.
+//
+// Every tick the alive fraction is checked against a trigger threshold
+// (lowered by `thresholdStep` after each run). Crossing it hands the
+// monitor's alive mask and residual energies to the protocol's fitness and
+// warm-starts its Snake Optimizer from its population and history; the
+// population is re-scored against the degraded network, and the run then
+// advances by at most `budget` fitness evaluations per tick, so its cost is
+// spread over simulated time instead of stalling one event. When a run
+// finishes, the new parameters are pushed to the live components: power
+// control margin, duty-cycle sleep ratio and cluster election weight.
+class OnlineOptimizer {
+public:
+    OnlineOptimizer();
+
+    void Configure(EnhancedMEMOSTPProtocol& protocol, NodeMonitor& monitor, double aliveThreshold,
+                   double thresholdStep, int iterations, uint32_t budget);
+    // Components that receive updated parameters; any may be null
+    void Attach(TxPowerController* txPower, DutyCycleScheduler* dutyCycle, ClusterManager* clusters);
+    void Start(double startTime, double tickInterval);
+
+    uint32_t GetRunCount() const { return m_runs; }
+    uint64_t GetEvaluations() const { return m_evaluations; }
+
+    void PrintReport() const;
+
+private:
+    void Tick();
+    void Apply();
+
+    EnhancedMEMOSTPProtocol* m_protocol;
+    NodeMonitor* m_monitor;
+    TxPowerController* m_txPower;
+    DutyCycleScheduler* m_dutyCycle;
+    ClusterManager* m_clusters;
+
+    double m_nextTrigger;
+    double m_thresholdStep;
+    int m_iterations;
+    uint32_t m_budget;
+    double m_interval;
+
+    uint32_t m_runs;
+    uint64_t m_evaluations;
+    uint64_t m_runEvaluations;
+    uint32_t m_ticks;
+    double m_runStart;
+    double m_sliceTime;        // wall-clock seconds spent in ticks
+    double m_maxSliceTime;
+};
+
+#endif // ONLINE_OPTIMIZER_H
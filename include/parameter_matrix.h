@@ -0,0 +1,81 @@
+#ifndef PARAMETER_MATRIX_H
+#define PARAMETER_MATRIX_H
+
+#include "node_monitor.h"
+#include <vector>
+#include <cstdint>
+
+// Per-node protocol parameters in one contiguous block, one column per
+// parameter (energy weight, power control, sleep ratio), each column a
+// plain array over nodes.
+//
+// Nodes are grouped into regions: rings of equal width around the sink. A
+// parameter vector holds one (energy weight, power control, sleep ratio)
+// triple per region, region 0 nearest the sink; Expand() copies each
+// region's triple into the rows of its nodes. One region is the global
+// parameter set; as many regions as nodes gives every node its own.
+class ParameterMatrix {
+public:
+    enum Column : uint32_t { EnergyWeight = 0, PowerControl = 1, SleepRatio = 2 };
+    static const uint32_t kColumns = 3;
+
+    ParameterMatrix();
+
+    // How far a drained node's targets move (see ScoreNodes)
+    static constexpr double kDrainShift = 0.1;
+
+    void AssignRegions(ColumnView<double> x, ColumnView<double> y, uint32_t sinkId, uint32_t regions);
+
+    // Live network state, for re-optimizing while the simulation runs.
+    // Dead nodes drop out of Score(); until this is called every node is
+    // alive with a full battery.
+    void SetNodeState(ColumnView<uint8_t> alive, ColumnView<double> remaining, ColumnView<double> initial);
+    // Battery used, 0 full to 1 empty; and its mean over the alive nodes
+    ColumnView<double> DrainColumn() const { return ColumnView<double>(drain.data(), nodeCount); }
+    double GetMeanDrain() const;
+
+    // regionParams holds kColumns values per region
+    void Expand(const std::vector<double>& regionParams);
+    void Expand(const std::vector<double>& regionParams, double* values) const;
+
+    uint32_t GetNodeCount() const { return nodeCount; }
+    uint32_t GetRegionCount() const { return regionCount; }
+    uint32_t GetDimensions() const { return regionCount * kColumns; }
+    uint32_t GetRegion(uint32_t nodeId) const { return region[nodeId]; }
+
+    ColumnView<double> GetColumn(Column column) const {
+        return ColumnView<double>(values.data() + (size_t)column * nodeCount, nodeCount);
+    }
+    std::vector<double> CopyColumn(Column column) const;
+    double GetMean(Column column) const;
+
+    // Distance to the sink, 0 at the sink to 1 at the farthest node
+    ColumnView<double> DistanceColumn() const { return ColumnView<double>(distance.data(), nodeCount); }
+
+    // Analytic fitness over every node at once, 0-3 per node like the
+    // global model. Targets shift with distance to the sink: relays near it
+    // carry the network's traffic, so they should sleep less, trim more
+    // margin off short links and avoid head duty when drained; edge nodes
+    // the reverse. As a node's battery drains, its targets move by up to
+    // kDrainShift towards saving energy: more weight on residual energy in
+    // head election, more margin trimmed, more sleep. Branch-free over the
+    // contiguous columns so the node loop vectorizes; nodeScores receives
+    // the per-node values.
+    static void ScoreNodes(const double* values, const double* distance, const double* drain,
+                           size_t nodes, double* nodeScores);
+
+    // Mean fitness of regionParams over the alive nodes; scratch holds the
+    // expanded matrix and node scores between calls
+    double Score(const std::vector<double>& regionParams, std::vector<double>& scratch) const;
+
+private:
+    uint32_t nodeCount;
+    uint32_t regionCount;
+    std::vector<double> values;      // kColumns x nodeCount, column-major
+    std::vector<double> distance;
+    std::vector<double> drain;
+    std::vector<uint8_t> alive;
+    std::vector<uint32_t> region;
+};
+
+#endif // PARAMETER_MATRIX_H
@@ -0,0 +1,76 @@
+#ifndef PARETO_OPTIMIZER_H
+#define PARETO_OPTIMIZER_H
+
+#include "rng_stream.h"
+#include <vector>
+#include <string>
+#include <random>
+#include <functional>
+#include <cstdint>
+
+// NSGA-II multi-objective search over the same parameter box as
+// EnhancedSnakeOptimizer. Each generation breeds offspring by binary
+// tournament on (rank, crowding distance), SBX crossover and polynomial
+// mutation, scores them as one batch, and keeps the best half of parents
+// plus offspring by non-dominated rank, breaking ties within the last front
+// that fits by crowding distance. The result is the first front: parameter
+// sets none of which is beaten on every objective by another.
+class ParetoOptimizer {
+public:
+    // objectives[i] receives one value per objective for candidates[i]
+    typedef std::function<void(const std::vector<std::vector<double>>& candidates,
+                               std::vector<std::vector<double>>& objectives)> ObjectiveFunction;
+
+    struct Objective {
+        std::string name;
+        bool maximize;
+    };
+
+    struct Solution {
+        std::vector<double> params;
+        std::vector<double> objectives;
+        uint32_t rank;
+        double crowding;
+    };
+
+    ParetoOptimizer(const std::vector<Objective>& objectives, ObjectiveFunction evaluate);
+
+    void setPopulationSize(uint32_t size);
+    void setRandomStream(const RngStream& stream) { rng = stream; }
+
+    const std::vector<Solution>& optimize(int generations);
+    const std::vector<Solution>& getFront() const { return front; }
+
+    // Operating point from the front: "balanced" is the knee, the point
+    // closest to the ideal after normalizing each objective over the front;
+    // an objective name picks the best point for that objective alone.
+    bool pick(const std::string& criterion, Solution& solution) const;
+    std::string criteria() const;
+
+    // Comma-separated, one row per front point, '#' header for gnuplot
+    // (set datafile separator ",")
+    bool exportFront(const std::string& filename) const;
+    void printFront() const;
+
+private:
+    bool dominates(const Solution& a, const Solution& b) const;
+    double cost(const Solution& s, size_t objective) const;
+    void rankAndCrowd(std::vector<Solution>& solutions) const;
+    void assignCrowding(std::vector<Solution>& solutions, const std::vector<size_t>& members) const;
+    const Solution& tournament(const std::vector<Solution>& pool);
+    void breed(const Solution& a, const Solution& b, std::vector<double>& childA, std::vector<double>& childB);
+    void mutate(std::vector<double>& params);
+    void evaluate(std::vector<Solution>& solutions);
+    void extractFront();
+
+    std::vector<Objective> objectiveSpec;
+    ObjectiveFunction evaluateBatch;
+    uint32_t populationSize;
+    RngStream rng;
+
+    std::vector<Solution> population;
+    std::vector<Solution> front;
+    uint64_t evaluations;
+};
+
+#endif // PARETO_OPTIMIZER_H
@@ -0,0 +1,50 @@
+#ifndef RNG_STREAM_H
+#define RNG_STREAM_H
+
+#include <cstdint>
+
+// Counter-based random stream (Philox2x64-10, Salmon et al., SC'11).
+// Value i of a stream is a keyed bijection of the counter (i / 2, stream),
+// so the whole state is three integers: streams never need to be stepped
+// to be independent, jump anywhere in O(1) and checkpoint as plain data.
+// Satisfies UniformRandomBitGenerator for the <random> distributions.
+class RngStream {
+public:
+    typedef uint64_t result_type;
+
+    RngStream() : RngStream(0, 0) {}
+    RngStream(uint64_t key, uint64_t stream, uint64_t position = 0);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        uint64_t block = position >> 1;
+        if (block != cachedBlock) {
+            Generate(block);
+        }
+        return output[position++ & 1];
+    }
+
+    // Uniform in [0, 1) with 53 random bits
+    double NextDouble() { return ((*this)() >> 11) * (1.0 / 9007199254740992.0); }
+
+    void Seek(uint64_t newPosition) { position = newPosition; }
+    uint64_t GetKey() const { return key; }
+    uint64_t GetStream() const { return stream; }
+    uint64_t GetPosition() const { return position; }
+
+    // One Philox2x64-10 block: counter (c0, c1) under key k
+    static void Block(uint64_t c0, uint64_t c1, uint64_t k, uint64_t out[2]);
+
+private:
+    void Generate(uint64_t block);
+
+    uint64_t key;
+    uint64_t stream;
+    uint64_t position;
+    uint64_t cachedBlock;
+    uint64_t output[2];
+};
+
+#endif // RNG_STREAM_H
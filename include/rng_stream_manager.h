@@ -0,0 +1,40 @@
+#ifndef RNG_STREAM_MANAGER_H
+#define RNG_STREAM_MANAGER_H
+
+#include "ns3/core-module.h"
+#include "ns3/random-variable-stream.h"
+#include "rng_stream.h"
+#include <string>
+#include <cstdint>
+
+// One place that turns ns-3's --RngSeed/--RngRun into every random stream
+// the program draws from. Components ask for a stream by name (and an
+// index, e.g. the node id), so the numbers one component sees never
+// depend on what other components drew or in which order they were
+// created, and the same seed and run reproduce a run bit for bit.
+//
+// ns-3 random variables get a fixed stream number per name and index in
+// place of ns-3's automatic allocation, which follows creation order.
+class RngStreamManager {
+public:
+    static RngStreamManager& Instance() {
+        static RngStreamManager instance;
+        return instance;
+    }
+
+    // Seed and run are read from RngSeedManager on every call, so streams
+    // follow the command line once it has been parsed.
+    RngStream GetStream(const std::string& name, uint64_t index = 0) const;
+    void AssignStream(ns3::Ptr<ns3::RandomVariableStream> variable, const std::string& name,
+                      uint64_t index = 0) const;
+
+    uint64_t GetKey() const;
+    static uint64_t StreamId(const std::string& name, uint64_t index);
+
+private:
+    RngStreamManager() = default;
+    RngStreamManager(const RngStreamManager&) = delete;
+    RngStreamManager& operator=(const RngStreamManager&) = delete;
+};
+
+#endif // RNG_STREAM_MANAGER_H
@@ -0,0 +1,70 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "energy_model_helper.h"
+#include "duty_cycle_scheduler.h"
+#include "data_aggregator.h"
+#include "node_monitor.h"
+#include <cstdint>
+
+// Everything needed to rebuild the deployment: layout, radio, energy and
+// the protocol settings the optimizer does not tune. The main simulation
+// and the optimizer's sub-simulations build their networks from the same
+// description, so candidates are scored on the deployment they will run on.
+struct Scenario {
+    uint32_t nNodes = 25;
+    double area = 400.0;
+    double simulationTime = 60.0;
+    uint32_t sinkNode = 0;
+
+    // Grid layout
+    double gridOrigin = 20.0;
+    double gridSpacing = 15.0;
+
+    // Energy
+    double initialEnergy = 100.0;
+    double deathThreshold = NodeMonitor::kDeathThreshold;
+    RadioHardwareProfile radio;
+
+    // Link budget (log-distance, 802.11b at 2 Mbps)
+    double pathLossExponent = 3.0;
+    double referenceLoss = 46.677;
+    double txPowerDbm = 20.0;          // maximum; power control trims per node
+    double rxSensitivityDbm = -101.0;
+
+    // Power control and duty cycling
+    bool powerControl = false;
+    double txPowerMin = 0.0;
+    double txPowerUpdate = 5.0;
+    uint32_t txRedundancy = 1;         // nearest neighbours kept in reach (resilience)
+    double dutyPeriod = 0.0;
+    DutyCycleScheduler::WakeMode wakeMode = DutyCycleScheduler::WakeMode::Staggered;
+
+    // Clustered sensing
+    double clusterFraction = 0.1;
+    double clusterRound = 20.0;
+    double readingInterval = 2.0;
+    double aggWindow = 5.0;
+    DataAggregator::Function aggregation = DataAggregator::Function::Mean;
+    uint32_t aggCap = 32;
+
+    uint32_t GetGridSize() const;
+
+    // Unit-disk radio range: the distance at which the log-distance loss
+    // eats the whole link budget
+    double GetLinkBudgetRange() const;
+
+    // Identifies the deployment for cached evaluations; any field change
+    // gives a different hash
+    uint64_t Hash() const;
+
+    void InstallMobility(ns3::NodeContainer& nodes) const;
+    ns3::NetDeviceContainer InstallRadios(ns3::NodeContainer& nodes) const;
+    ns3::Ipv4InterfaceContainer InstallInternet(ns3::NodeContainer& nodes,
+                                                ns3::NetDeviceContainer& devices) const;
+};
+
+#endif // SCENARIO_H
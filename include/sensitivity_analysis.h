@@ -0,0 +1,98 @@
+#ifndef SENSITIVITY_ANALYSIS_H
+#define SENSITIVITY_ANALYSIS_H
+
+#include "rng_stream.h"
+#include <vector>
+#include <string>
+#include <functional>
+#include <cstdint>
+
+// Global sensitivity of model outputs to the protocol parameters, to see
+// which knobs are worth optimizing before spending a full optimization.
+//
+// Sobol: Saltelli's scheme on N quasi-random base points (Sobol sequence
+// over 2k dimensions split into matrices A and B, plus k matrices AB_i
+// that take column i from B), N(k+2) model runs. First-order indices S_i
+// (Saltelli 2010) give the share of output variance due to parameter i
+// alone; total indices ST_i (Jansen) add every interaction it takes part
+// in. Confidence half-widths come from bootstrapping the base points.
+//
+// Morris: r one-at-a-time trajectories on a 4-level grid, r(k+1) runs.
+// mu* (mean absolute elementary effect, per unit of the parameter's range)
+// ranks influence; sigma large next to mu* means non-linear or interacting.
+//
+// All points are generated up front and scored in batches, so a batch
+// evaluator can run them in parallel. Base points whose runs failed (a
+// non-finite output) are left out of the estimates.
+class SensitivityAnalysis {
+public:
+    // outputs[i] receives one value per output for candidates[i]
+    typedef std::function<void(const std::vector<std::vector<double>>& candidates,
+                               std::vector<std::vector<double>>& outputs)> ModelFunction;
+
+    enum class Method { Sobol, Morris };
+
+    struct Parameter {
+        std::string name;
+        double lower;
+        double upper;
+    };
+
+    // Sobol fills first/total and their confidence half-widths; Morris
+    // fills muStar, mu and sigma
+    struct Index {
+        double first;
+        double firstCi;
+        double total;
+        double totalCi;
+        double muStar;
+        double mu;
+        double sigma;
+    };
+
+    SensitivityAnalysis(const std::vector<Parameter>& parameters,
+                        const std::vector<std::string>& outputs, ModelFunction model);
+
+    static bool parseMethod(const std::string& name, Method& method);
+
+    // Candidates per model call, 0 = all at once
+    void setBatchSize(uint32_t size) { batchSize = size; }
+    void setBootstrap(uint32_t resamples) { bootstrapResamples = resamples; }
+    // Morris directions and bootstrap resampling
+    void setRandomStream(const RngStream& stream) { rng = stream; }
+
+    // samples = base points (Sobol) or trajectories (Morris). Returns false
+    // if too few runs succeeded to estimate anything.
+    bool run(Method method, uint32_t samples);
+
+    // indices[output][parameter]
+    const std::vector<std::vector<Index>>& getIndices() const { return indices; }
+    uint64_t getEvaluationCount() const { return evaluations; }
+    uint32_t getUsableSamples() const { return usableSamples; }
+
+    void printReport() const;
+    // Comma-separated, one row per output and parameter, '#' header
+    bool exportCsv(const std::string& filename) const;
+
+private:
+    void evaluate(const std::vector<std::vector<double>>& candidates,
+                  std::vector<std::vector<double>>& values);
+    std::vector<double> scale(const std::vector<double>& unit) const;
+    bool runSobol(uint32_t samples);
+    bool runMorris(uint32_t trajectories);
+
+    std::vector<Parameter> parameterSpec;
+    std::vector<std::string> outputNames;
+    ModelFunction model;
+    uint32_t batchSize;
+    uint32_t bootstrapResamples;
+    RngStream rng;
+
+    Method method;
+    uint32_t requestedSamples;
+    uint32_t usableSamples;
+    uint64_t evaluations;
+    std::vector<std::vector<Index>> indices;
+};
+
+#endif // SENSITIVITY_ANALYSIS_H
@@ -0,0 +1,93 @@
+#ifndef SIMULATION_EVALUATOR_H
+#define SIMULATION_EVALUATOR_H
+
+#include "fitness_evaluator.h"
+#include "scenario.h"
+#include <sys/types.h>
+#include <vector>
+#include <cstdint>
+
+class FitnessCache;
+
+// What one sub-simulation measured. Plain data; it crosses the worker pipes
+// as raw bytes.
+struct SimulationOutcome {
+    uint32_t valid;             // 0 if the sub-simulation failed
+    uint32_t reserved;
+    double lifetime;            // projected first node death (s)
+    double deliveryRatio;       // readings delivered / generated, 0-1
+    double averageDelay;        // reading latency (s)
+    double energyConsumed;      // network total over the sub-simulation (J)
+    double energyPerReading;    // J per delivered reading
+    uint64_t readingsDelivered;
+};
+
+// Scores candidates by simulating them. Each candidate runs a short
+// sub-simulation of the scenario in clustered mode, the workload in which
+// all three parameters act (head rotation, link margin, radio sleep).
+//
+// Start() forks a pool of worker processes; ns-3 keeps its simulator, node
+// list and address allocator in process globals, so parallel runs need
+// separate processes. Each worker forks once more per candidate: the
+// grandchild starts from the worker's untouched state, which keeps every
+// sub-simulation independent of what ran before it on that worker and
+// isolates the pool from a run that aborts. Call Start() before this
+// process creates any ns-3 objects or threads so workers inherit none.
+class SimulationFitnessEvaluator : public FitnessEvaluator {
+public:
+    SimulationFitnessEvaluator(const Scenario& scenario, double duration);
+    ~SimulationFitnessEvaluator() override;
+
+    // 0 workers = one per core. Returns false if no worker could be started.
+    bool Start(uint32_t workers);
+    void Stop();
+    bool IsRunning() const { return !m_workers.empty(); }
+    uint32_t GetWorkerCount() const { return (uint32_t)m_workers.size(); }
+
+    void Evaluate(const std::vector<std::vector<double>>& candidates,
+                  std::vector<double>& fitness) override;
+    std::string GetName() const override { return "simulation"; }
+
+    // Raw outcomes, for callers that weigh the objectives themselves.
+    void Simulate(const std::vector<std::vector<double>>& candidates,
+                  std::vector<SimulationOutcome>& outcomes);
+
+    // Lifetime (s), delivery ratio, reading delay (s) and energy per
+    // delivered sensor bit (J; a reading carries a 64-bit timestamp and a
+    // 64-bit value), for multi-objective search. Outcomes are memoized in
+    // the cache, when given, under their own context.
+    void EvaluateObjectives(const std::vector<std::vector<double>>& candidates,
+                            std::vector<std::vector<double>>& objectives,
+                            FitnessCache* cache = nullptr);
+
+    // 0.4 lifetime + 0.4 delivery + 0.2 energy, each normalized to 0-1
+    // against the scenario's simulation time and energy budget.
+    double Score(const SimulationOutcome& outcome) const;
+
+    uint64_t GetSimulationCount() const { return m_simulations; }
+
+    // Scenario, sub-simulation length and scoring version, for caching
+    uint64_t GetContextHash() const;
+
+    // Builds and runs one sub-simulation in the calling process.
+    static SimulationOutcome RunSubSimulation(const Scenario& scenario,
+                                              const std::vector<double>& params,
+                                              double duration);
+
+private:
+    struct Worker {
+        pid_t pid;
+        int requestFd;
+        int responseFd;
+    };
+
+    static void WorkerLoop(const Scenario& scenario, double duration,
+                           int requestFd, int responseFd);
+
+    Scenario m_scenario;
+    double m_duration;
+    std::vector<Worker> m_workers;
+    uint64_t m_simulations;
+};
+
+#endif // SIMULATION_EVALUATOR_H
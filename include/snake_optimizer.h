@@ -1,41 +1,174 @@
 #ifndef SNAKE_OPTIMIZER_H
 #define SNAKE_OPTIMIZER_H
 
+#include "rng_stream.h"
 #include <vector>
 #include <cmath>
 #include <random>
+#include <memory>
+#include <string>
 #include <iostream>
 #include <iomanip>
+#include <cstdint>
 
+class ThreadPool;
+class FitnessEvaluator;
+class ParameterMatrix;
+
+// Snake Optimizer (Hashim & Hussien, 2022). The population is split into a
+// male and a female half. Each iteration the food quantity Q and temperature
+// pick the phase: exploration around random mates while food is scarce,
+// then movement towards the food (the best snake) while it is hot, and
+// fight or mating moves between the halves once it cools. Every snake
+// moves and is scored on the pool in parallel, each with its own RNG
+// stream, so a run does not depend on how work lands on threads. Without a
+// FitnessEvaluator candidates are scored by the built-in analytic model, or
+// with a parameter layout by its per-node kernel; a candidate then holds
+// one parameter triple per region.
+//
+// A run can also be driven in slices: start() prepares it and each step()
+// spends at most a given number of fitness evaluations, so a simulation can
+// re-optimize between events. A warm start keeps the population, puts the
+// most recent bests from the history in place of its weakest quarter and
+// re-scores everything before the first generation.
+//
+// optimize() can checkpoint its state after every few generations and
+// resume from the file. A resumed run continues exactly: it draws the
+// same numbers and returns the same result as one that was never
+// interrupted.
 class EnhancedSnakeOptimizer {
-private:
-    std::vector<double> bestParams;
-    std::mt19937 rng;
-    
 public:
-    EnhancedSnakeOptimizer() : rng(std::random_device{}()) {
-        bestParams = {0.6, 0.7, 0.3};
-    }
+    struct Snake {
+        std::vector<double> position;
+        double fitness;
+    };
+
+    EnhancedSnakeOptimizer();
+    ~EnhancedSnakeOptimizer();
+
+    // Snakes per generation (at least 4, rounded up to even) and fitness
+    // threads (0 = all cores)
+    void setPopulationSize(uint32_t size);
+    void setThreadCount(uint32_t threads) { threadCount = threads; }
+    // Generation-level draws; each snake gets a child stream keyed from it
+    void setRandomStream(const RngStream& stream) { rng = stream; }
+    uint32_t getPopulationSize() const { return populationSize; }
     
-    std::vector<double> optimize(int iterations);
+    // Scores whole generations in place of the analytic model; not owned
+    void setFitnessEvaluator(FitnessEvaluator* evaluator) { fitnessEvaluator = evaluator; }
     
-    double getBestEnergyWeight(const std::vector<double>& params) const { 
-        return params.size() > 0 ? params[0] : 0.6; 
-    }
+    // Per-region parameters over the layout's regions; not owned, null for
+    // one global triple
+    void setParameterLayout(const ParameterMatrix* matrix);
+    size_t getDimensions() const { return lower.size(); }
     
-    double getBestPowerControl(const std::vector<double>& params) const { 
-        return params.size() > 1 ? params[1] : 0.7; 
-    }
+    // Mean battery drain of the live network (0 full, 1 empty); the
+    // analytic model moves its targets towards saving energy with it
+    void setNetworkDrain(double drain) { networkDrain = drain; }
+
+    // With resume set, continues the run in the checkpoint file if it
+    // matches this one, otherwise starts afresh
+    std::vector<double> optimize(int iterations, bool resume = false);
     
-    double getBestSleepRatio(const std::vector<double>& params) const { 
-        return params.size() > 2 ? params[2] : 0.3; 
-    }
+    // Written by optimize() every `every` generations and at the end,
+    // through a temporary file so a crash leaves the last complete one.
+    // `context` identifies what is being optimized (scenario, fitness);
+    // a checkpoint with a different context is not resumed. Empty path = off.
+    void setCheckpoint(const std::string& path, uint64_t context, uint32_t every = 1);
     
-    void printOptimizationResults(const std::vector<double>& params) const;
+    // Incremental runs. step() returns true once the run has finished;
+    // budget 0 = no limit.
+    void start(int iterations, bool warm);
+    bool step(uint32_t budget);
+    bool isRunning() const { return running; }
+    
+    // Where the next cold start begins, e.g. parameters applied without
+    // optimizing
+    void setStartingPoint(const std::vector<double>& params);
+    const std::vector<double>& getBestParams() const { return bestParams; }
     
+    // Best snake after every generation since the last cold start
+    const std::vector<Snake>& getHistory() const { return history; }
+
+    double getBestEnergyWeight(const std::vector<double>& params) const {
+        return params.size() > 0 ? params[0] : 0.6;
+    }
+
+    double getBestPowerControl(const std::vector<double>& params) const {
+        return params.size() > 1 ? params[1] : 0.7;
+    }
+
+    double getBestSleepRatio(const std::vector<double>& params) const {
+        return params.size() > 2 ? params[2] : 0.3;
+    }
+
+    // Search box and starting point, shared with the other optimizers
+    static const std::vector<double>& getLowerBounds() { return lowerBounds; }
+    static const std::vector<double>& getUpperBounds() { return upperBounds; }
+    static const std::vector<double>& getDefaultParams() { return defaultParams; }
+
+    double getBestFitness() const { return bestFitness; }
+    uint64_t getEvaluationCount() const { return evaluations; }
+
+    void printOptimizationResults(const std::vector<double>& params) const;
+
 private:
-    double fitnessFunction(const std::vector<double>& params);
-    void updateSnakePosition(std::vector<double>& params, int iteration, int totalIterations);
+    double fitnessFunction(const std::vector<double>& params) const;
+
+    void initializePopulation();
+    void warmStart();
+    void beginGeneration();
+    void finishGeneration();
+    void evaluate(std::vector<Snake>& snakes, size_t first, size_t count);
+    void moveSnake(size_t index, double temperature, double food,
+                   bool fight, std::vector<double>& position);
+    void clampToBounds(std::vector<double>& position) const;
+    void updateBest();
+    void preparePool();
+    bool saveCheckpoint() const;
+    bool loadCheckpoint(int iterations);
+
+    static const std::vector<double> lowerBounds;
+    static const std::vector<double> upperBounds;
+    static const std::vector<double> defaultParams;
+
+    uint32_t populationSize;
+    uint32_t threadCount;
+    std::unique_ptr<ThreadPool> pool;
+    FitnessEvaluator* fitnessEvaluator;
+    const ParameterMatrix* layout;
+    double networkDrain;
+    std::vector<double> lower;           // bounds repeated per region
+    std::vector<double> upper;
+
+    RngStream rng;
+    std::vector<RngStream> streams;   // one per snake
+
+    // [0, half) males, [half, populationSize) females
+    std::vector<Snake> population;
+    size_t bestMale;
+    size_t bestFemale;
+
+    std::vector<double> bestParams;
+    double bestFitness;
+    uint64_t evaluations;
+    std::vector<Snake> history;
+    
+    // Run state between step() calls. The batch being scored is the
+    // population itself before the first generation, then the offspring
+    // (and any eggs, after the last snake) of each generation.
+    bool running;
+    bool scoringPopulation;
+    int runIterations;
+    int iteration;
+    size_t scored;
+    bool hatching;
+    std::vector<Snake> offspring;
+    
+    std::string checkpointPath;
+    uint64_t checkpointContext;
+    uint32_t checkpointEvery;
+    bool checkpointing;           // only optimize() runs write checkpoints
 };
 
-#endif // SNAKE_OPTIMIZER_H
\ No newline at end of file
+#endif // SNAKE_OPTIMIZER_H
@@ -0,0 +1,34 @@
+#ifndef SOBOL_SEQUENCE_H
+#define SOBOL_SEQUENCE_H
+
+#include <vector>
+#include <cstdint>
+
+// Sobol low-discrepancy sequence in [0, 1)^d with the Joe & Kuo (2008)
+// direction numbers, generated in Gray-code order (Antonov & Saleev). The
+// first 2^m points of every coordinate fill the 2^m equal bins exactly
+// once, so a few hundred points cover a small parameter box far more
+// evenly than independent random draws. Unscrambled and deterministic; the
+// all-zero first point is skipped.
+class SobolSequence {
+public:
+    static constexpr uint32_t kMaxDimensions = 10;
+
+    explicit SobolSequence(uint32_t dimensions);
+
+    uint32_t GetDimensions() const { return dimensions; }
+    uint64_t GetIndex() const { return index; }
+
+    // point is resized to the dimension count
+    void Next(std::vector<double>& point);
+
+private:
+    static constexpr uint32_t kBits = 32;
+
+    uint32_t dimensions;
+    uint64_t index;
+    std::vector<uint32_t> direction;   // kBits per dimension
+    std::vector<uint32_t> state;
+};
+
+#endif // SOBOL_SEQUENCE_H
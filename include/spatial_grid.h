@@ -0,0 +1,44 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+// Uniform bucket grid over node positions for fixed-radius neighbour
+// queries. Buckets are cellSize wide; a radius query only visits the
+// buckets overlapping the query disk.
+class SpatialGrid {
+public:
+    SpatialGrid();
+
+    void Configure(double minX, double minY, double maxX, double maxY, double cellSize);
+
+    void Insert(uint32_t id, double x, double y);
+    void Remove(uint32_t id);
+    bool Contains(uint32_t id) const;
+
+    double GetX(uint32_t id) const { return posX[id]; }
+    double GetY(uint32_t id) const { return posY[id]; }
+
+    // Calls visit(id) for every stored id within radius of (x, y).
+    void ForEachInRadius(double x, double y, double radius,
+                         const std::function<void(uint32_t)>& visit) const;
+
+private:
+    int CellX(double x) const;
+    int CellY(double y) const;
+
+    double originX;
+    double originY;
+    double cellSize;
+    int cellsX;
+    int cellsY;
+
+    std::vector<std::vector<uint32_t>> buckets;
+    std::vector<double> posX;
+    std::vector<double> posY;
+    std::vector<int32_t> bucketOf;   // -1 when the id is not stored
+};
+
+#endif // SPATIAL_GRID_H
@@ -0,0 +1,71 @@
+#ifndef SURROGATE_OPTIMIZER_H
+#define SURROGATE_OPTIMIZER_H
+
+#include "gaussian_process.h"
+#include "rng_stream.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+class ThreadPool;
+class FitnessEvaluator;
+
+// Surrogate-assisted search over the EnhancedSnakeOptimizer parameter box
+// for fitness that is expensive to measure, such as sub-simulations. A
+// Gaussian process is fitted to every point evaluated so far, and each
+// round only the candidates with the highest expected improvement over
+// the best fitness go to the real evaluator. They go in one call, so a
+// batch evaluator can score them all at once.
+//
+// A round's batch is picked with the kriging believer heuristic: after each
+// pick the model treats its own prediction there as observed, which
+// collapses the uncertainty around it and sends the next pick elsewhere.
+// Expected improvement is maximized over quasi-random points spread over
+// the box plus points scattered around the best ones so far, scored on a
+// thread pool.
+class SurrogateOptimizer {
+public:
+    explicit SurrogateOptimizer(FitnessEvaluator* evaluator);
+    ~SurrogateOptimizer();
+
+    // Real evaluations in total, and per round (one evaluator call)
+    void setBudget(uint32_t evaluations) { budget = evaluations > 0 ? evaluations : 1; }
+    void setBatchSize(uint32_t size) { batchSize = size > 0 ? size : 1; }
+    // Space-filling points before the first model; 0 = max(2d + 2, batch)
+    void setInitialSamples(uint32_t samples) { initialSamples = samples; }
+    // Expected-improvement threads (0 = all cores)
+    void setThreadCount(uint32_t threads) { threadCount = threads; }
+    // Candidate rotation and local scatter
+    void setRandomStream(const RngStream& stream) { rng = stream; }
+
+    std::vector<double> optimize();
+
+    const std::vector<double>& getBestParams() const { return bestParams; }
+    double getBestFitness() const { return bestFitness; }
+    uint64_t getEvaluationCount() const { return points.size(); }
+
+    void printResults() const;
+
+private:
+    std::vector<double> toParams(const std::vector<double>& unit) const;
+    void evaluate(const std::vector<std::vector<double>>& batch);
+    void selectBatch(size_t count, std::vector<std::vector<double>>& batch);
+
+    FitnessEvaluator* evaluator;
+    uint32_t budget;
+    uint32_t batchSize;
+    uint32_t initialSamples;
+    uint32_t threadCount;
+    std::unique_ptr<ThreadPool> pool;
+    RngStream rng;
+    GaussianProcess model;
+
+    // Evaluated points in unit coordinates, and their fitness
+    std::vector<std::vector<double>> points;
+    std::vector<double> values;
+    std::vector<double> bestParams;
+    double bestFitness;
+    uint32_t rounds;
+};
+
+#endif // SURROGATE_OPTIMIZER_H
@@ -0,0 +1,132 @@
+#ifndef TELEMETRY_SINK_H
+#define TELEMETRY_SINK_H
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <functional>
+
+// Live telemetry channel in a POSIX shared-memory segment (shm_open).
+//
+// The simulator is the single writer and never blocks: it overwrites the
+// oldest event slot when the ring is full. Any number of local readers can
+// attach, detach and re-attach at any time and catch up from the ring and
+// the node-state table. The segment is left in place when the simulator
+// exits (writerState = 2) so late readers still see the final state; it is
+// recreated by the next run.
+//
+// Segment layout (host byte order, offsets in bytes):
+//
+//   0                      TelemetryHeader            (128 bytes)
+//   nodeTableOffset        TelemetryNodeRecord[nodeCapacity]   (32 bytes each)
+//   ringOffset             slot[slotCount], slotSize bytes each
+//
+//   slot:  0  uint64  sequence   (seqlock: 0 while being written, else
+//                                 slot sequence number + 1)
+//          8  double  simTime    (s)
+//         16  uint32  length     (payload bytes stored in this slot)
+//         20  uint32  flags      (bit 0: event truncated, bit 1: more
+//                                 fragments follow, bit 2: continues the
+//                                 event in the previous slot)
+//         24  char    payload[slotSize - 24]   JSON event line fragment, no '\n'
+//
+// An event longer than one slot's payload (e.g. a frame listing many nodes)
+// is split over consecutive slots; its payload is the concatenation of the
+// fragments. Slot n lives at n % slotCount. header.writeSeq is the number of
+// slots published so far and only advances once every fragment of an event
+// is written; slots [writeSeq - slotCount, writeSeq) are readable. A reader
+// copies a slot, then re-reads its sequence: if it changed (or is not n + 1)
+// the slot was overwritten and its event is lost. Node records use the same
+// scheme with an odd/even seqlock counter.
+struct TelemetryHeader {
+    char magic[8];                      // "WSNTEL01"
+    uint32_t version;                   // 2
+    uint32_t headerSize;                // sizeof(TelemetryHeader)
+    uint32_t nodeCapacity;
+    uint32_t nodeRecordSize;            // sizeof(TelemetryNodeRecord)
+    uint32_t slotCount;
+    uint32_t slotSize;
+    uint64_t nodeTableOffset;
+    uint64_t ringOffset;
+    std::atomic<uint64_t> writeSeq;
+    std::atomic<uint32_t> writerState;  // 0 = initializing, 1 = running, 2 = finished
+    uint32_t writerPid;
+    std::atomic<uint64_t> simTimeBits;  // latest simulation time (double bits)
+    uint8_t reserved[56];
+};
+
+struct TelemetryNodeRecord {
+    std::atomic<uint32_t> seq;          // odd while the writer updates the record
+    uint32_t nodeId;
+    double energy;                      // remaining energy (J), -1 if unknown
+    double updateTime;                  // simulation time of last update (s)
+    uint8_t alive;
+    uint8_t reserved[7];
+};
+
+static_assert(sizeof(TelemetryHeader) == 128, "TelemetryHeader layout changed");
+static_assert(sizeof(TelemetryNodeRecord) == 32, "TelemetryNodeRecord layout changed");
+
+class TelemetrySink {
+public:
+    TelemetrySink();
+    ~TelemetrySink();
+
+    bool Open(const std::string& name, uint32_t nodeCapacity,
+              uint32_t slotCount = 65536, uint32_t slotSize = 512);
+    void Close();
+    bool IsOpen() const { return header != nullptr; }
+
+    void PublishEvent(const std::string& line, double simTime);
+    void UpdateNode(uint32_t nodeId, double energy, bool alive, double simTime);
+
+    uint64_t GetEventsPublished() const { return eventsPublished; }
+    uint64_t GetEventsTruncated() const { return eventsTruncated; }
+
+private:
+    TelemetrySink(const TelemetrySink&) = delete;
+    TelemetrySink& operator=(const TelemetrySink&) = delete;
+
+    std::string shmName;
+    TelemetryHeader* header;
+    uint8_t* base;
+    size_t mappedSize;
+    uint64_t eventsPublished;
+    uint64_t eventsTruncated;
+};
+
+// Reader side of the channel, for local consumers and tools.
+class TelemetryReader {
+public:
+    TelemetryReader();
+    ~TelemetryReader();
+
+    // fromStart=false starts at the current head (live tail only).
+    bool Attach(const std::string& name, bool fromStart = true);
+    void Detach();
+    bool IsAttached() const { return header != nullptr; }
+    bool IsWriterFinished() const;
+
+    // Deliver every event published since the last poll; returns the number
+    // delivered. Events overwritten before they could be read are counted
+    // in GetEventsDropped(); a multi-slot event the reader fell behind on
+    // counts once per lost slot.
+    size_t Poll(const std::function<void(double simTime, const std::string& line)>& onEvent,
+                size_t maxEvents = SIZE_MAX);
+
+    bool ReadNode(uint32_t nodeId, TelemetryNodeRecord& out) const;
+    uint32_t GetNodeCapacity() const;
+    uint64_t GetEventsDropped() const { return eventsDropped; }
+
+private:
+    TelemetryReader(const TelemetryReader&) = delete;
+    TelemetryReader& operator=(const TelemetryReader&) = delete;
+
+    const TelemetryHeader* header;
+    const uint8_t* base;
+    size_t mappedSize;
+    uint64_t nextSeq;
+    uint64_t eventsDropped;
+};
+
+#endif // TELEMETRY_SINK_H
@@ -0,0 +1,48 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+
+// Fixed set of worker threads for data-parallel loops. ParallelFor hands out
+// indices one at a time, so uneven work items balance themselves; the calling
+// thread takes part and the call returns once every index has run. Only one
+// ParallelFor may be in flight per pool.
+class ThreadPool {
+public:
+    // 0 threads = std::thread::hardware_concurrency()
+    explicit ThreadPool(uint32_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Runs fn(index) for index in [0, count).
+    void ParallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+    // Workers plus the calling thread.
+    uint32_t GetThreadCount() const { return (uint32_t)workers.size() + 1; }
+
+private:
+    void WorkerLoop();
+    void RunItems();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    const std::function<void(size_t)>* job;
+    size_t jobCount;
+    std::atomic<size_t> nextIndex;
+    uint64_t generation;
+    uint32_t busyWorkers;
+    bool stopping;
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,81 @@
+#ifndef TX_POWER_CONTROLLER_H
+#define TX_POWER_CONTROLLER_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+#include <map>
+#include <vector>
+
+// Per-node transmit power control from measured link loss.
+//
+// Every received frame gives a path-loss sample for its transmitter
+// (the power that frame was sent at minus RSSI), smoothed per link. Each
+// transmitter remembers the power of its last few frames by packet uid, so
+// frames in flight or received late across a power change are not
+// mis-attributed; a frame no longer remembered gives no sample.
+//
+// Each update builds a minimum spanning tree over the alive nodes using the
+// estimated losses, so the reduced-power graph stays connected. Each node
+// then uses the lowest power that still reaches its MST neighbours and its
+// `redundancy` nearest neighbours, plus a target link margin. The margin
+// comes from the optimizer's power-control parameter: a higher value trims
+// power harder.
+class TxPowerController {
+public:
+    TxPowerController();
+
+    void Configure(ns3::NetDeviceContainer& devices, double minPowerDbm, double maxPowerDbm,
+                   double rxSensitivityDbm, double powerControl, uint32_t redundancy = 1);
+    void Start(double firstUpdate, double updateInterval);
+
+    // Recompute immediately when a node dies; its links drop out of the tree.
+    void NodeDied(uint32_t nodeId);
+
+    void SetRedundancy(uint32_t redundancy) { m_redundancy = redundancy; }
+    // New margin from a re-optimized power-control parameter; applied at
+    // once if the controller is already running
+    void SetPowerControl(double powerControl);
+    // Per-node parameters; GetTargetMargin() then returns the mean margin
+    void SetPowerControl(const std::vector<double>& powerControl);
+    double GetTargetMargin() const { return m_marginDb; }
+    double GetTxPower(uint32_t nodeId) const { return m_txPower[nodeId]; }
+    double GetAverageTxPower() const;
+
+    void PrintReport() const;
+
+private:
+    void OnSnifferTx(uint32_t sender, ns3::Ptr<const ns3::Packet> packet, uint16_t channelFreqMhz,
+                     ns3::WifiTxVector txVector, ns3::MpduInfo mpdu, uint16_t staId);
+    void OnSnifferRx(uint32_t receiver, ns3::Ptr<const ns3::Packet> packet, uint16_t channelFreqMhz,
+                     ns3::WifiTxVector txVector, ns3::MpduInfo mpdu,
+                     ns3::SignalNoiseDbm signalNoise, uint16_t staId);
+    void PeriodicUpdate();
+    void Update();
+    double LinkLoss(uint32_t a, uint32_t b) const;
+    void ApplyTxPower(uint32_t nodeId, double dbm);
+
+    ns3::NetDeviceContainer m_devices;
+    std::map<ns3::Mac48Address, uint32_t> m_macToNode;
+    double m_minPower;
+    double m_maxPower;
+    double m_rxSensitivity;
+    double m_marginDb;
+    std::vector<double> m_nodeMarginDb;   // empty = m_marginDb for every node
+    uint32_t m_redundancy;
+    double m_interval;
+
+    std::vector<uint8_t> m_alive;
+    std::vector<double> m_txPower;
+    std::vector<double> m_loss;   // N x N smoothed path loss (dB), < 0 = never heard
+
+    struct SentFrame {
+        uint64_t uid;
+        double txPowerDbm;
+    };
+    std::vector<SentFrame> m_sent;         // per node, a ring of its recent frames
+    std::vector<uint32_t> m_sentNext;
+    uint32_t m_updates;
+};
+
+#endif // TX_POWER_CONTROLLER_H
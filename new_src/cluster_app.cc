@@ -0,0 +1,211 @@
+#include "cluster_app.h"
+#include "event_emitter.h"
+#include "duty_cycle_scheduler.h"
+#include "rng_stream_manager.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/udp-socket-factory.h"
+#include <cstring>
+
+namespace {
+
+const uint8_t kReadingPacket = 1;
+const uint8_t kAggregatePacket = 2;
+
+template <typename T>
+void Put(std::vector<uint8_t>& out, T value) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+template <typename T>
+bool Get(const std::vector<uint8_t>& in, size_t& pos, T& value) {
+    if (pos + sizeof(T) > in.size()) return false;
+    memcpy(&value, in.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+ns3::TypeId ClusterTrafficApplication::GetTypeId() {
+    static ns3::TypeId tid = ns3::TypeId("ClusterTrafficApplication")
+        .SetParent<ns3::Application>()
+        .AddConstructor<ClusterTrafficApplication>();
+    return tid;
+}
+
+ClusterTrafficApplication::ClusterTrafficApplication()
+    : m_clusters(nullptr), m_protocol(nullptr), m_nodeId(0), m_port(0),
+      m_readingInterval(1.0), m_aggregationWindow(5.0), m_packetCounter(0), m_dutyCycle(nullptr) {}
+
+void ClusterTrafficApplication::Setup(ClusterManager* clusters, EnhancedMEMOSTPProtocol* protocol,
+                                      uint32_t nodeId, const std::vector<ns3::Ipv4Address>& addresses,
+                                      uint16_t port, double readingInterval, double aggregationWindow,
+                                      DataAggregator::Function function, uint32_t concatCap) {
+    m_clusters = clusters;
+    m_protocol = protocol;
+    m_nodeId = nodeId;
+    m_addresses = addresses;
+    m_port = port;
+    m_readingInterval = readingInterval;
+    m_aggregationWindow = aggregationWindow;
+    m_aggregator = DataAggregator(function, concatCap);
+}
+
+void ClusterTrafficApplication::StartApplication() {
+    m_socket = ns3::Socket::CreateSocket(GetNode(), ns3::UdpSocketFactory::GetTypeId());
+    m_socket->Bind(ns3::InetSocketAddress(ns3::Ipv4Address::GetAny(), m_port));
+    m_socket->SetRecvCallback(ns3::MakeCallback(&ClusterTrafficApplication::HandleRead, this));
+    
+    if (m_nodeId == m_clusters->GetSink()) {
+        EventEmitter::Instance().EmitNodeEvent(m_nodeId, "sink_started");
+        return;
+    }
+    
+    m_sensor = ns3::CreateObject<ns3::UniformRandomVariable>();
+    RngStreamManager::Instance().AssignStream(m_sensor, "cluster_sensor", m_nodeId);
+    
+    // Spread the first readings so members do not all transmit at once.
+    double jitter = m_sensor->GetValue(0.0, m_readingInterval);
+    m_readingEvent = ns3::Simulator::Schedule(ns3::Seconds(jitter),
+                                              &ClusterTrafficApplication::GenerateReading, this);
+    m_forwardEvent = ns3::Simulator::Schedule(ns3::Seconds(m_aggregationWindow),
+                                              &ClusterTrafficApplication::ForwardAggregate, this);
+}
+
+void ClusterTrafficApplication::StopApplication() {
+    if (m_readingEvent.IsRunning()) {
+        ns3::Simulator::Cancel(m_readingEvent);
+    }
+    if (m_forwardEvent.IsRunning()) {
+        ns3::Simulator::Cancel(m_forwardEvent);
+    }
+    if (m_flushEvent.IsRunning()) {
+        ns3::Simulator::Cancel(m_flushEvent);
+    }
+    m_pending.clear();
+    if (m_socket) {
+        m_socket->Close();
+    }
+    
+    EventEmitter::Instance().EmitNodeEvent(m_nodeId, "app_stopped");
+}
+
+void ClusterTrafficApplication::GenerateReading() {
+    double now = ns3::Simulator::Now().GetSeconds();
+    double value = m_sensor->GetValue(15.0, 35.0);
+    m_clusters->RecordReadingGenerated();
+    
+    uint32_t head = m_clusters->GetHead(m_nodeId);
+    if (head == m_nodeId) {
+        AddToAggregate(m_nodeId, now, value);
+    } else {
+        std::vector<uint8_t> plaintext;
+        Put(plaintext, kReadingPacket);
+        Put(plaintext, m_nodeId);
+        Put(plaintext, now);
+        Put(plaintext, value);
+        SendTo(head, plaintext);
+    }
+    
+    m_readingEvent = ns3::Simulator::Schedule(ns3::Seconds(m_readingInterval),
+                                              &ClusterTrafficApplication::GenerateReading, this);
+}
+
+void ClusterTrafficApplication::AddToAggregate(uint32_t source, double time, double value) {
+    m_aggregator.Add(source, time, value);
+    if (m_aggregator.IsFull()) {
+        SendAggregate();
+    }
+}
+
+void ClusterTrafficApplication::SendAggregate() {
+    if (m_aggregator.IsEmpty()) return;
+    
+    std::vector<uint8_t> plaintext;
+    Put(plaintext, kAggregatePacket);
+    Put(plaintext, m_nodeId);
+    uint32_t count = m_aggregator.Flush(plaintext);
+    
+    SendTo(m_clusters->GetSink(), plaintext);
+    m_clusters->RecordAggregateSent(count);
+}
+
+void ClusterTrafficApplication::ForwardAggregate() {
+    SendAggregate();
+    m_forwardEvent = ns3::Simulator::Schedule(ns3::Seconds(m_aggregationWindow),
+                                              &ClusterTrafficApplication::ForwardAggregate, this);
+}
+
+void ClusterTrafficApplication::SendTo(uint32_t nodeId, const std::vector<uint8_t>& plaintext) {
+    uint32_t packetId = ++m_packetCounter;
+    EventEmitter::Instance().EmitEvent("packet_tx", packetId, m_nodeId, nodeId);
+    
+    std::vector<uint8_t> payload = m_protocol->encryptPacket(plaintext, m_nodeId, packetId);
+    if (payload.empty()) return;
+    
+    ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>(payload.data(), payload.size());
+    if (m_dutyCycle && m_dutyCycle->TimeUntilRendezvous() > 0.0) {
+        m_pending.push_back({packet, nodeId, ns3::Simulator::Now().GetSeconds()});
+        if (!m_flushEvent.IsRunning()) {
+            m_flushEvent = ns3::Simulator::Schedule(ns3::Seconds(m_dutyCycle->TimeUntilRendezvous()),
+                                                    &ClusterTrafficApplication::FlushPending, this);
+        }
+        return;
+    }
+    m_socket->SendTo(packet, 0, ns3::InetSocketAddress(m_addresses[nodeId], m_port));
+}
+
+void ClusterTrafficApplication::FlushPending() {
+    double now = ns3::Simulator::Now().GetSeconds();
+    double wait = m_dutyCycle->TimeUntilRendezvous();
+    if (wait > 0.0) {
+        m_flushEvent = ns3::Simulator::Schedule(ns3::Seconds(wait), &ClusterTrafficApplication::FlushPending, this);
+        return;
+    }
+    
+    while (!m_pending.empty()) {
+        const PendingFrame& frame = m_pending.front();
+        m_dutyCycle->RecordDeferral(m_nodeId, now - frame.queuedAt);
+        m_socket->SendTo(frame.packet, 0, ns3::InetSocketAddress(m_addresses[frame.destination], m_port));
+        m_pending.pop_front();
+    }
+}
+
+void ClusterTrafficApplication::HandleRead(ns3::Ptr<ns3::Socket> socket) {
+    ns3::Ptr<ns3::Packet> packet;
+    ns3::Address from;
+    
+    while ((packet = socket->RecvFrom(from))) {
+        std::vector<uint8_t> buffer(packet->GetSize());
+        packet->CopyData(buffer.data(), buffer.size());
+        
+        uint32_t packetId = ++m_packetCounter;
+        std::vector<uint8_t> plaintext = m_protocol->decryptPacket(buffer, m_nodeId, packetId);
+        
+        size_t pos = 0;
+        uint8_t type = 0;
+        uint32_t source = 0;
+        if (!Get(plaintext, pos, type) || !Get(plaintext, pos, source)) continue;
+        
+        EventEmitter::Instance().EmitEvent("packet_rx", packetId, static_cast<int>(source), m_nodeId);
+        double now = ns3::Simulator::Now().GetSeconds();
+        
+        if (type == kReadingPacket) {
+            double time = 0.0, value = 0.0;
+            if (!Get(plaintext, pos, time) || !Get(plaintext, pos, value)) continue;
+            
+            if (m_nodeId == m_clusters->GetSink()) {
+                m_clusters->RecordDelivered(1, now - time);
+            } else {
+                AddToAggregate(source, time, value); // also covers members that still think we are head
+            }
+        } else if (type == kAggregatePacket && m_nodeId == m_clusters->GetSink()) {
+            DataAggregator::Frame frame;
+            if (!DataAggregator::Decode(plaintext, pos, frame)) continue;
+            m_clusters->RecordDelivered(frame.readings, now - frame.meanTime);
+        }
+    }
+}
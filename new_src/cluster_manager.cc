@@ -0,0 +1,196 @@
+#include "cluster_manager.h"
+#include "event_emitter.h"
+#include "rng_stream_manager.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+ClusterManager::ClusterManager()
+    : m_monitor(nullptr), m_sink(0), m_headFraction(0.1), m_energyWeight(0.6),
+      m_roundLength(20.0), m_round(0), m_totalHeads(0),
+      m_readingsGenerated(0), m_readingsForwarded(0), m_aggregatesSent(0),
+      m_readingsDelivered(0), m_latencySum(0.0) {}
+
+void ClusterManager::Configure(NodeMonitor& monitor, uint32_t sinkId, double headFraction,
+                               double energyWeight, double roundLength) {
+    m_monitor = &monitor;
+    m_sink = sinkId;
+    m_headFraction = std::max(0.01, std::min(1.0, headFraction));
+    SetEnergyWeight(energyWeight);
+    m_roundLength = roundLength;
+    m_round = 0;
+    
+    uint32_t n = monitor.GetNodeCount();
+    m_head.assign(n, sinkId);
+    m_isHead.assign(n, 0);
+    m_lastHeadRound.assign(n, -1);
+    m_headTerms.assign(n, 0);
+    m_heads.clear();
+    m_totalHeads = 0;
+    
+    m_rng = CreateObject<UniformRandomVariable>();
+    RngStreamManager::Instance().AssignStream(m_rng, "cluster_election");
+}
+
+void ClusterManager::SetEnergyWeight(double energyWeight) {
+    m_energyWeight = std::max(0.0, std::min(1.0, energyWeight));
+    m_nodeEnergyWeight.clear();
+}
+
+void ClusterManager::SetEnergyWeight(const std::vector<double>& energyWeight) {
+    m_nodeEnergyWeight.resize(energyWeight.size());
+    for (size_t i = 0; i < energyWeight.size(); ++i) {
+        m_nodeEnergyWeight[i] = std::max(0.0, std::min(1.0, energyWeight[i]));
+    }
+}
+
+void ClusterManager::Start(double startTime) {
+    Simulator::Schedule(Seconds(startTime), &ClusterManager::ElectHeads, this);
+}
+
+double ClusterManager::ElectionThreshold(uint32_t nodeId) const {
+    uint32_t epoch = std::max<uint32_t>(1, static_cast<uint32_t>(std::round(1.0 / m_headFraction)));
+    
+    // Served within the current epoch: not eligible.
+    if (m_lastHeadRound[nodeId] >= 0 && m_round - m_lastHeadRound[nodeId] < epoch) return 0.0;
+    
+    double p = m_headFraction;
+    double threshold = p / (1.0 - p * (m_round % epoch));
+    
+    double initial = m_monitor->InitialEnergyColumn()[nodeId];
+    double residual = (initial > 0) ? m_monitor->RemainingEnergyColumn()[nodeId] / initial : 1.0;
+    double w = nodeId < m_nodeEnergyWeight.size() ? m_nodeEnergyWeight[nodeId] : m_energyWeight;
+    return threshold * (w * residual + (1.0 - w));
+}
+
+void ClusterManager::ElectHeads() {
+    uint32_t n = m_monitor->GetNodeCount();
+    ColumnView<uint8_t> alive = m_monitor->AliveColumn();
+    
+    std::fill(m_isHead.begin(), m_isHead.end(), 0);
+    m_heads.clear();
+    
+    for (uint32_t i = 0; i < n; ++i) {
+        if (i == m_sink || !alive[i]) continue;
+        if (m_rng->GetValue() < ElectionThreshold(i)) {
+            m_isHead[i] = 1;
+            m_heads.push_back(i);
+        }
+    }
+    
+    // LEACH can elect nobody; fall back to the best-charged alive node.
+    if (m_heads.empty()) {
+        ColumnView<double> energy = m_monitor->RemainingEnergyColumn();
+        int64_t best = -1;
+        for (uint32_t i = 0; i < n; ++i) {
+            if (i == m_sink || !alive[i]) continue;
+            if (best < 0 || energy[i] > energy[best]) best = i;
+        }
+        if (best >= 0) {
+            m_isHead[best] = 1;
+            m_heads.push_back(static_cast<uint32_t>(best));
+        }
+    }
+    
+    for (uint32_t head : m_heads) {
+        m_lastHeadRound[head] = m_round;
+        m_headTerms[head]++;
+        EventEmitter::Instance().EmitNodeEvent(head, "cluster_head",
+                                               m_monitor->RemainingEnergyColumn()[head]);
+    }
+    m_totalHeads += m_heads.size();
+    
+    AssignMembers();
+    EventEmitter::Instance().EmitEvent("cluster_round", m_round, static_cast<int>(m_heads.size()));
+    
+    m_round++;
+    Simulator::Schedule(Seconds(m_roundLength), &ClusterManager::ElectHeads, this);
+}
+
+void ClusterManager::AssignMembers() {
+    uint32_t n = m_monitor->GetNodeCount();
+    ColumnView<double> x = m_monitor->PositionXColumn();
+    ColumnView<double> y = m_monitor->PositionYColumn();
+    
+    for (uint32_t i = 0; i < n; ++i) {
+        if (m_isHead[i] || i == m_sink) {
+            m_head[i] = m_isHead[i] ? i : m_sink;
+            continue;
+        }
+        
+        // Joining the nearest head stands in for the strongest advertisement.
+        uint32_t best = m_sink;
+        double bestDist = std::hypot(x[i] - x[m_sink], y[i] - y[m_sink]);
+        for (uint32_t head : m_heads) {
+            double d = std::hypot(x[i] - x[head], y[i] - y[head]);
+            if (d < bestDist) {
+                best = head;
+                bestDist = d;
+            }
+        }
+        m_head[i] = best;
+    }
+}
+
+uint32_t ClusterManager::GetHead(uint32_t nodeId) const {
+    if (nodeId >= m_head.size()) return m_sink;
+    
+    uint32_t head = m_head[nodeId];
+    // A head that died mid-round is bypassed until the next election.
+    return m_monitor->IsNodeAlive(head) ? head : m_sink;
+}
+
+bool ClusterManager::IsHead(uint32_t nodeId) const {
+    return nodeId < m_isHead.size() && m_isHead[nodeId];
+}
+
+void ClusterManager::RecordDelivered(uint32_t readings, double latency) {
+    m_readingsDelivered += readings;
+    m_latencySum += latency * readings;
+}
+
+double ClusterManager::GetDeliveryRatio() const {
+    return (m_readingsGenerated > 0) ? (double)m_readingsDelivered / m_readingsGenerated * 100.0 : 0.0;
+}
+
+double ClusterManager::GetAverageLatency() const {
+    return (m_readingsDelivered > 0) ? m_latencySum / m_readingsDelivered : 0.0;
+}
+
+void ClusterManager::PrintReport() const {
+    uint32_t maxTerms = 0;
+    for (uint32_t terms : m_headTerms) maxTerms = std::max(maxTerms, terms);
+    
+    // Residual energy spread across alive nodes shows whether rotation is
+    // spreading the head load.
+    ColumnView<double> energy = m_monitor->RemainingEnergyColumn();
+    ColumnView<uint8_t> alive = m_monitor->AliveColumn();
+    double sum = 0.0, sumSq = 0.0;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < energy.size(); ++i) {
+        if (!alive[i] || i == m_sink) continue;
+        sum += energy[i];
+        sumSq += energy[i] * energy[i];
+        count++;
+    }
+    double mean = (count > 0) ? sum / count : 0.0;
+    double stddev = (count > 0) ? std::sqrt(std::max(0.0, sumSq / count - mean * mean)) : 0.0;
+    
+    std::cout << "\n\033[1;33m🛰️  CLUSTERING (LEACH, energy-weighted):\033[0m" << std::endl;
+    std::cout << "├─ Rounds:                 " << m_round << " x " << std::fixed << std::setprecision(1)
+              << m_roundLength << " s" << std::endl;
+    std::cout << "├─ Heads per Round:        " << std::setprecision(2)
+              << (m_round > 0 ? (double)m_totalHeads / m_round : 0.0)
+              << " (p = " << m_headFraction << ")" << std::endl;
+    std::cout << "├─ Max Terms per Node:     " << maxTerms << std::endl;
+    std::cout << "├─ Residual Energy:        " << std::setprecision(3) << mean << " ± "
+              << stddev << " J" << std::endl;
+    std::cout << "├─ Readings Generated:     " << m_readingsGenerated << std::endl;
+    std::cout << "├─ Aggregates Sent:        " << m_aggregatesSent << " (" << m_readingsForwarded
+              << " readings)" << std::endl;
+    std::cout << "├─ Reading Delivery Ratio: " << std::setprecision(2) << GetDeliveryRatio() << "%" << std::endl;
+    std::cout << "└─ Reading Latency:        " << std::setprecision(4) << GetAverageLatency() << " s" << std::endl;
+}
@@ -0,0 +1,166 @@
+#include "connectivity_tracker.h"
+#include "event_emitter.h"
+#include <algorithm>
+
+ConnectivityTracker::ConnectivityTracker()
+    : commRange(0.0), sinkId(0), nodeCount(0), built(false),
+      componentCount(0), partitionTime(-1.0), visitEpoch(0) {}
+
+void ConnectivityTracker::Configure(double areaSize, double range, uint32_t sink) {
+    commRange = range;
+    sinkId = sink;
+    nodeCount = 0;
+    built = false;
+    componentCount = 0;
+    partitionTime = -1.0;
+
+    alive.clear();
+    label.clear();
+    componentSize.clear();
+    sizeHistogram.clear();
+
+    // Buckets one radio range wide: a neighbour query visits at most 3x3.
+    grid.Configure(0.0, 0.0, areaSize, areaSize, std::max(range, 1.0));
+}
+
+void ConnectivityTracker::AddNode(uint32_t nodeId, double x, double y) {
+    if (built) return;
+
+    if (nodeId >= nodeCount) {
+        nodeCount = nodeId + 1;
+        alive.resize(nodeCount, 0);
+    }
+    grid.Insert(nodeId, x, y);
+    alive[nodeId] = 1;
+}
+
+uint32_t ConnectivityTracker::Find(uint32_t x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+void ConnectivityTracker::Build() {
+    parent.resize(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; ++i) parent[i] = i;
+
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        if (!alive[i]) continue;
+        grid.ForEachInRadius(grid.GetX(i), grid.GetY(i), commRange, [this, i](uint32_t j) {
+            if (j <= i) return;
+            uint32_t a = Find(i), b = Find(j);
+            if (a != b) parent[std::max(a, b)] = std::min(a, b);
+        });
+    }
+
+    // Union-find roots become the initial component labels.
+    label.assign(nodeCount, UINT32_MAX);
+    componentSize.assign(nodeCount, 0);
+    sizeHistogram.clear();
+    componentCount = 0;
+
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        if (!alive[i]) continue;
+        label[i] = Find(i);
+        componentSize[label[i]]++;
+    }
+    for (uint32_t root = 0; root < nodeCount; ++root) {
+        if (componentSize[root] > 0) AddComponentSize(componentSize[root]);
+    }
+
+    visited.assign(nodeCount, 0);
+    visitEpoch = 0;
+    built = true;
+
+    if (componentCount > 1) {
+        partitionTime = 0.0;
+    }
+}
+
+void ConnectivityTracker::AddComponentSize(uint32_t size) {
+    sizeHistogram[size]++;
+    componentCount++;
+}
+
+void ConnectivityTracker::DropComponentSize(uint32_t size) {
+    auto it = sizeHistogram.find(size);
+    if (it == sizeHistogram.end()) return;
+    if (--it->second == 0) sizeHistogram.erase(it);
+    componentCount--;
+}
+
+void ConnectivityTracker::Relabel(uint32_t start, uint32_t newLabel) {
+    queue.clear();
+    queue.push_back(start);
+    visited[start] = visitEpoch;
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        uint32_t u = queue[head];
+        label[u] = newLabel;
+        grid.ForEachInRadius(grid.GetX(u), grid.GetY(u), commRange, [this](uint32_t v) {
+            if (visited[v] != visitEpoch) {
+                visited[v] = visitEpoch;
+                queue.push_back(v);
+            }
+        });
+    }
+    componentSize[newLabel] = static_cast<uint32_t>(queue.size());
+}
+
+void ConnectivityTracker::RemoveNode(uint32_t nodeId, double currentTime) {
+    if (!built || nodeId >= nodeCount || !alive[nodeId]) return;
+
+    uint32_t oldLabel = label[nodeId];
+    alive[nodeId] = 0;
+    label[nodeId] = UINT32_MAX;
+    double x = grid.GetX(nodeId);
+    double y = grid.GetY(nodeId);
+    grid.Remove(nodeId);
+
+    DropComponentSize(componentSize[oldLabel]);
+    componentSize[oldLabel] = 0;
+
+    // Every surviving neighbour was in oldLabel; each BFS that starts from an
+    // unvisited one discovers one piece of the split component.
+    std::vector<uint32_t> neighbours;
+    grid.ForEachInRadius(x, y, commRange, [&neighbours](uint32_t v) { neighbours.push_back(v); });
+
+    visitEpoch++;
+    for (uint32_t v : neighbours) {
+        if (visited[v] == visitEpoch) continue;
+        uint32_t newLabel = static_cast<uint32_t>(componentSize.size());
+        componentSize.push_back(0);
+        Relabel(v, newLabel);
+        AddComponentSize(componentSize[newLabel]);
+    }
+
+    if (partitionTime < 0 && componentCount > 1) {
+        partitionTime = currentTime;
+        EventEmitter::Instance().EmitMetric("partition_time", currentTime, "s");
+    }
+}
+
+uint32_t ConnectivityTracker::GetLargestComponentSize() const {
+    return sizeHistogram.empty() ? 0 : sizeHistogram.rbegin()->first;
+}
+
+double ConnectivityTracker::GetLargestComponentRatio() const {
+    return (nodeCount > 0) ? (double)GetLargestComponentSize() / nodeCount * 100.0 : 0.0;
+}
+
+bool ConnectivityTracker::IsSinkReachable(uint32_t nodeId) const {
+    if (!built || nodeId >= nodeCount || sinkId >= nodeCount) return false;
+    if (!alive[nodeId] || !alive[sinkId]) return false;
+    return label[nodeId] == label[sinkId];
+}
+
+uint32_t ConnectivityTracker::GetSinkReachableCount() const {
+    if (!built || sinkId >= nodeCount || !alive[sinkId]) return 0;
+    return componentSize[label[sinkId]];
+}
+
+double ConnectivityTracker::GetSinkReachableRatio() const {
+    return (nodeCount > 0) ? (double)GetSinkReachableCount() / nodeCount * 100.0 : 0.0;
+}
@@ -0,0 +1,85 @@
+#include "coverage_engine.h"
+#include <algorithm>
+#include <cmath>
+
+CoverageEngine::CoverageEngine()
+    : areaSize(0.0), sensingRadius(0.0), cellSize(1.0), k(2), cellsPerSide(0),
+      coveredCells(0), kCoveredCells(0) {}
+
+void CoverageEngine::Configure(double area, double radius, double cell, uint32_t kLevel) {
+    areaSize = area;
+    sensingRadius = radius;
+    cellSize = std::max(cell, 1e-3);
+    k = std::max<uint32_t>(1, kLevel);
+    cellsPerSide = std::max(1, static_cast<int>(std::ceil(areaSize / cellSize)));
+
+    counts.assign(static_cast<size_t>(cellsPerSide) * cellsPerSide, 0);
+    coveredCells = 0;
+    kCoveredCells = 0;
+
+    // Buckets one sensing radius wide: a radius query visits at most 3x3.
+    grid.Configure(0.0, 0.0, areaSize, areaSize, std::max(radius, cellSize));
+}
+
+void CoverageEngine::AddNode(uint32_t nodeId, double x, double y) {
+    if (!IsConfigured() || grid.Contains(nodeId)) return;
+
+    grid.Insert(nodeId, x, y);
+    StampDisk(x, y, +1);
+}
+
+void CoverageEngine::RemoveNode(uint32_t nodeId) {
+    if (!IsConfigured() || !grid.Contains(nodeId)) return;
+
+    StampDisk(grid.GetX(nodeId), grid.GetY(nodeId), -1);
+    grid.Remove(nodeId);
+}
+
+void CoverageEngine::StampDisk(double x, double y, int delta) {
+    // Cells whose centre (i + 0.5) * cellSize lies within the radius.
+    int x0 = std::max(0, static_cast<int>(std::ceil((x - sensingRadius) / cellSize - 0.5)));
+    int x1 = std::min(cellsPerSide - 1, static_cast<int>(std::floor((x + sensingRadius) / cellSize - 0.5)));
+    int y0 = std::max(0, static_cast<int>(std::ceil((y - sensingRadius) / cellSize - 0.5)));
+    int y1 = std::min(cellsPerSide - 1, static_cast<int>(std::floor((y + sensingRadius) / cellSize - 0.5)));
+    double r2 = sensingRadius * sensingRadius;
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        double dy = (cy + 0.5) * cellSize - y;
+        double rem = r2 - dy * dy;
+        if (rem < 0.0) continue;
+
+        // Horizontal chord of the disk on this row.
+        double half = std::sqrt(rem);
+        int cx0 = std::max(x0, static_cast<int>(std::ceil((x - half) / cellSize - 0.5)));
+        int cx1 = std::min(x1, static_cast<int>(std::floor((x + half) / cellSize - 0.5)));
+
+        uint16_t* row = counts.data() + static_cast<size_t>(cy) * cellsPerSide;
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            uint16_t& c = row[cx];
+            if (delta > 0) {
+                if (c == UINT16_MAX) continue;
+                c++;
+                if (c == 1) coveredCells++;
+                if (c == k) kCoveredCells++;
+            } else if (c > 0) {
+                if (c == 1) coveredCells--;
+                if (c == k) kCoveredCells--;
+                c--;
+            }
+        }
+    }
+}
+
+double CoverageEngine::GetCoverage() const {
+    return counts.empty() ? 0.0 : (double)coveredCells / counts.size() * 100.0;
+}
+
+double CoverageEngine::GetKCoverage() const {
+    return counts.empty() ? 0.0 : (double)kCoveredCells / counts.size() * 100.0;
+}
+
+uint32_t CoverageEngine::CountCoveringNodes(double x, double y) const {
+    uint32_t n = 0;
+    grid.ForEachInRadius(x, y, sensingRadius, [&n](uint32_t) { n++; });
+    return n;
+}
@@ -1,9 +1,12 @@
 #include "crypto_app.h"
 #include "event_emitter.h"
-#include "ns3/random-variable-stream.h"
+#include "duty_cycle_scheduler.h"
+#include "rng_stream_manager.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 ns3::TypeId CryptoTestApplication::GetTypeId() {
@@ -15,7 +18,8 @@ ns3::TypeId CryptoTestApplication::GetTypeId() {
 
 CryptoTestApplication::CryptoTestApplication() 
     : m_socket(0), m_peerPort(0), m_packetSize(512), 
-      m_isReceiver(false), m_nodeId(0), m_packetCounter(0) {}
+      m_isReceiver(false), m_nodeId(0), m_packetCounter(0),
+      m_dutyCycle(nullptr) {}
 
 void CryptoTestApplication::Setup(ns3::Ptr<ns3::Socket> socket, ns3::Address address, uint16_t port, 
                                  uint32_t packetSize, EnhancedMEMOSTPProtocol* protocol, 
@@ -27,6 +31,7 @@ void CryptoTestApplication::Setup(ns3::Ptr<ns3::Socket> socket, ns3::Address add
     m_protocol = protocol;
     m_isReceiver = isReceiver;
     m_nodeId = nodeId;
+    m_payload = RngStreamManager::Instance().GetStream("crypto_payload", nodeId);
 }
 
 void CryptoTestApplication::StartApplication() {
@@ -49,6 +54,10 @@ void CryptoTestApplication::StopApplication() {
     if (m_sendEvent.IsRunning()) {
         ns3::Simulator::Cancel(m_sendEvent);
     }
+    if (m_flushEvent.IsRunning()) {
+        ns3::Simulator::Cancel(m_flushEvent);
+    }
+    m_pending.clear();
     
     if (m_socket) {
         m_socket->Close();
@@ -58,11 +67,11 @@ void CryptoTestApplication::StopApplication() {
 }
 
 void CryptoTestApplication::SendPacket() {
+    // Eight payload bytes per draw from the node's stream
     std::vector<uint8_t> data(m_packetSize);
-    ns3::Ptr<ns3::UniformRandomVariable> uv = ns3::CreateObject<ns3::UniformRandomVariable>();
-    
-    for (size_t i = 0; i < m_packetSize; i++) {
-        data[i] = uv->GetInteger(0, 255);
+    for (size_t i = 0; i < m_packetSize; i += 8) {
+        uint64_t word = m_payload();
+        memcpy(data.data() + i, &word, std::min<size_t>(8, m_packetSize - i));
     }
     
     uint32_t packetId = ++m_packetCounter;
@@ -76,7 +85,17 @@ void CryptoTestApplication::SendPacket() {
     
     if (!encryptedData.empty()) {
         ns3::Ptr<ns3::Packet> packet = ns3::Create<ns3::Packet>(encryptedData.data(), encryptedData.size());
-        m_socket->Send(packet);
+        
+        // Held until the next hop and the relays after it are awake as well
+        if (m_dutyCycle && m_dutyCycle->TimeUntilRendezvous() > 0.0) {
+            m_pending.emplace_back(packet, ns3::Simulator::Now().GetSeconds());
+            if (!m_flushEvent.IsRunning()) {
+                m_flushEvent = ns3::Simulator::Schedule(ns3::Seconds(m_dutyCycle->TimeUntilRendezvous()),
+                                                        &CryptoTestApplication::FlushPending, this);
+            }
+        } else {
+            m_socket->Send(packet);
+        }
         
         EventEmitter::Instance().EmitMetric("packet_size", encryptedData.size(), "bytes");
     }
@@ -84,6 +103,21 @@ void CryptoTestApplication::SendPacket() {
     m_sendEvent = ns3::Simulator::Schedule(ns3::Seconds(0.5), &CryptoTestApplication::SendPacket, this);
 }
 
+void CryptoTestApplication::FlushPending() {
+    double now = ns3::Simulator::Now().GetSeconds();
+    double wait = m_dutyCycle->TimeUntilRendezvous();
+    if (wait > 0.0) {
+        m_flushEvent = ns3::Simulator::Schedule(ns3::Seconds(wait), &CryptoTestApplication::FlushPending, this);
+        return;
+    }
+    
+    while (!m_pending.empty()) {
+        m_dutyCycle->RecordDeferral(m_nodeId, now - m_pending.front().second);
+        m_socket->Send(m_pending.front().first);
+        m_pending.pop_front();
+    }
+}
+
 void CryptoTestApplication::HandleRead(ns3::Ptr<ns3::Socket> socket) {
     ns3::Ptr<ns3::Packet> packet;
     ns3::Address from;
@@ -0,0 +1,122 @@
+#include "data_aggregator.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+template <typename T>
+void Put(std::vector<uint8_t>& out, T value) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+template <typename T>
+bool Get(const std::vector<uint8_t>& in, size_t& pos, T& value) {
+    if (pos + sizeof(T) > in.size()) return false;
+    memcpy(&value, in.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+const char* kFunctionNames[] = {"min", "max", "mean", "count", "concat"};
+
+} // namespace
+
+DataAggregator::DataAggregator(Function fn, uint32_t cap)
+    : function(fn), concatCap(std::max<uint32_t>(1, std::min<uint32_t>(cap, UINT16_MAX))),
+      readings(0), timeSum(0.0), valueSum(0.0),
+      minValue(std::numeric_limits<double>::infinity()),
+      maxValue(-std::numeric_limits<double>::infinity()) {}
+
+bool DataAggregator::ParseFunction(const std::string& name, Function& fn) {
+    for (uint8_t i = 0; i < sizeof(kFunctionNames) / sizeof(kFunctionNames[0]); ++i) {
+        if (name == kFunctionNames[i]) {
+            fn = static_cast<Function>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* DataAggregator::FunctionName(Function fn) {
+    return kFunctionNames[static_cast<uint8_t>(fn)];
+}
+
+void DataAggregator::Add(uint32_t source, double time, double value) {
+    readings++;
+    timeSum += time;
+    valueSum += value;
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+    
+    if (function == Function::Concat) {
+        samples.emplace_back(source, value);
+    }
+}
+
+bool DataAggregator::IsFull() const {
+    return function == Function::Concat && samples.size() >= concatCap;
+}
+
+uint32_t DataAggregator::Flush(std::vector<uint8_t>& out) {
+    uint32_t count = readings;
+    if (count == 0) return 0;
+    
+    Put(out, static_cast<uint8_t>(function));
+    Put(out, count);
+    Put(out, timeSum / count);
+    
+    switch (function) {
+    case Function::Min: Put(out, minValue); break;
+    case Function::Max: Put(out, maxValue); break;
+    case Function::Mean: Put(out, valueSum / count); break;
+    case Function::Count: break;
+    case Function::Concat:
+        Put(out, static_cast<uint16_t>(samples.size()));
+        for (const auto& sample : samples) {
+            Put(out, sample.first);
+            Put(out, sample.second);
+        }
+        break;
+    }
+    
+    readings = 0;
+    timeSum = 0.0;
+    valueSum = 0.0;
+    minValue = std::numeric_limits<double>::infinity();
+    maxValue = -std::numeric_limits<double>::infinity();
+    samples.clear();
+    return count;
+}
+
+bool DataAggregator::Decode(const std::vector<uint8_t>& in, size_t pos, Frame& frame) {
+    uint8_t fn = 0;
+    if (!Get(in, pos, fn) || fn > static_cast<uint8_t>(Function::Concat)) return false;
+    if (!Get(in, pos, frame.readings) || !Get(in, pos, frame.meanTime)) return false;
+    
+    frame.function = static_cast<Function>(fn);
+    frame.value = 0.0;
+    frame.samples.clear();
+    
+    switch (frame.function) {
+    case Function::Min:
+    case Function::Max:
+    case Function::Mean:
+        return Get(in, pos, frame.value);
+    case Function::Count:
+        frame.value = frame.readings;
+        return true;
+    case Function::Concat: {
+        uint16_t n = 0;
+        if (!Get(in, pos, n)) return false;
+        for (uint16_t i = 0; i < n; ++i) {
+            std::pair<uint32_t, double> sample;
+            if (!Get(in, pos, sample.first) || !Get(in, pos, sample.second)) return false;
+            frame.samples.push_back(sample);
+        }
+        return true;
+    }
+    }
+    return false;
+}
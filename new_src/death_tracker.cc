@@ -0,0 +1,60 @@
+#include "death_tracker.h"
+#include "ns3/energy-module.h"
+
+using namespace ns3;
+
+DeathTracker::DeathTracker(NodeContainer& nodes, NodeMonitor& monitor, EnergyModelHelper& energy)
+    : m_nodes(nodes), m_monitor(monitor), m_energy(energy) {}
+
+void DeathTracker::Start() {
+    uint32_t n = m_nodes.GetN();
+    m_lastUpdate.assign(n, Simulator::Now().GetSeconds());
+    m_crossing.assign(n, -1.0);
+    
+    m_energy.SetDepletionCallback(MakeCallback(&DeathTracker::Depleted, this));
+    for (uint32_t i = 0; i < n; ++i) {
+        Ptr<EnergySource> source = m_nodes.Get(i)->GetObject<EnergySource>();
+        if (!source) continue;
+        
+        source->TraceConnectWithoutContext("RemainingEnergy",
+            MakeBoundCallback(&DeathTracker::OnRemainingEnergy, this, i));
+    }
+}
+
+void DeathTracker::OnRemainingEnergy(DeathTracker* tracker, uint32_t nodeId,
+                                     double oldValue, double newValue) {
+    tracker->EnergyChanged(nodeId, oldValue, newValue);
+}
+
+void DeathTracker::EnergyChanged(uint32_t nodeId, double oldValue, double newValue) {
+    if (!m_monitor.IsNodeAlive(nodeId)) return;
+    
+    double now = Simulator::Now().GetSeconds();
+    m_monitor.SetRemainingEnergy(nodeId, newValue);
+    
+    // The source traces the new level before it reports depletion
+    double drained = oldValue - newValue;
+    const double threshold = NodeMonitor::kDeathThreshold;
+    if (newValue <= threshold && oldValue > threshold && drained > 0.0) {
+        m_crossing[nodeId] = m_lastUpdate[nodeId] +
+            (now - m_lastUpdate[nodeId]) * (oldValue - threshold) / drained;
+    }
+    m_lastUpdate[nodeId] = now;
+}
+
+void DeathTracker::Depleted(uint32_t nodeId) {
+    if (nodeId >= m_crossing.size() || !m_monitor.IsNodeAlive(nodeId)) return;
+    
+    double deathTime = m_crossing[nodeId] >= 0.0 ? m_crossing[nodeId] : Simulator::Now().GetSeconds();
+    m_monitor.CheckNodeDeath(nodeId, deathTime, DeathCause::EnergyDepletion);
+    
+    // Disable node applications
+    Ptr<Node> node = m_nodes.Get(nodeId);
+    for (uint32_t appIdx = 0; appIdx < node->GetNApplications(); ++appIdx) {
+        node->GetApplication(appIdx)->SetStopTime(Simulator::Now());
+    }
+    
+    if (!m_onDeath.IsNull()) {
+        m_onDeath(nodeId);
+    }
+}
@@ -0,0 +1,207 @@
+#include "duty_cycle_scheduler.h"
+#include "energy_model_helper.h"
+#include "event_emitter.h"
+#include "ns3/wifi-module.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+namespace {
+
+// Kept clear at both ends of the rendezvous interval: wake-ups scheduled
+// for its first instant, and frames (with retries) still on the air at
+// its last
+const double kRendezvousGuard = 0.005;
+
+Ptr<WifiPhy> GetPhy(NetDeviceContainer& devices, uint32_t nodeId) {
+    Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(devices.Get(nodeId));
+    return device ? device->GetPhy() : nullptr;
+}
+
+} // namespace
+
+DutyCycleScheduler::DutyCycleScheduler()
+    : m_period(0.0), m_sleepRatio(0.0), m_awake(0.0), m_mode(WakeMode::Staggered),
+      m_stagger(0.0), m_rendezvousStart(0.0), m_rendezvousEnd(0.0), m_startTime(0.0), m_deferredPackets(0), m_totalDeferral(0.0), m_maxDeferral(0.0) {}
+
+bool DutyCycleScheduler::ParseWakeMode(const std::string& name, WakeMode& mode) {
+    if (name == "staggered") {
+        mode = WakeMode::Staggered;
+    } else if (name == "sync" || name == "synchronized") {
+        mode = WakeMode::Synchronized;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void DutyCycleScheduler::Configure(NetDeviceContainer& devices, double period, double sleepRatio,
+                                   WakeMode mode) {
+    m_devices = devices;
+    m_period = period;
+    m_mode = mode;
+    SetSleepRatio(sleepRatio);
+}
+
+void DutyCycleScheduler::SetSleepRatio(double sleepRatio) {
+    m_sleepRatio = std::max(0.0, std::min(0.95, sleepRatio));
+    m_awake = m_period * (1.0 - m_sleepRatio);
+    m_nodeAwake.clear();
+    UpdateWindows();
+}
+
+void DutyCycleScheduler::SetSleepRatio(const std::vector<double>& sleepRatio) {
+    if (sleepRatio.empty()) return;
+    
+    double sum = 0.0;
+    m_nodeAwake.resize(sleepRatio.size());
+    for (size_t i = 0; i < sleepRatio.size(); ++i) {
+        double ratio = std::max(0.0, std::min(0.95, sleepRatio[i]));
+        m_nodeAwake[i] = m_period * (1.0 - ratio);
+        sum += ratio;
+    }
+    m_sleepRatio = sum / sleepRatio.size();
+    m_awake = m_period * (1.0 - m_sleepRatio);
+    UpdateWindows();
+}
+
+double DutyCycleScheduler::Offset(uint32_t nodeId) const {
+    if (m_mode == WakeMode::Synchronized || m_devices.GetN() == 0) return 0.0;
+    return m_stagger * nodeId / m_devices.GetN();
+}
+
+void DutyCycleScheduler::UpdateWindows() {
+    uint32_t n = m_devices.GetN();
+    double shortest = m_awake;
+    for (uint32_t i = 0; i < n; ++i) {
+        shortest = std::min(shortest, AwakeTime(i));
+    }
+    m_stagger = (m_mode == WakeMode::Staggered) ? 0.5 * shortest : 0.0;
+    
+    // Latest wake-up to earliest sleep; at least half the shortest window
+    m_rendezvousStart = 0.0;
+    m_rendezvousEnd = m_period;
+    for (uint32_t i = 0; i < n; ++i) {
+        m_rendezvousStart = std::max(m_rendezvousStart, Offset(i));
+        m_rendezvousEnd = std::min(m_rendezvousEnd, Offset(i) + AwakeTime(i));
+    }
+    double guard = std::min(kRendezvousGuard, 0.25 * (m_rendezvousEnd - m_rendezvousStart));
+    m_rendezvousStart += guard;
+    m_rendezvousEnd -= guard;
+}
+
+void DutyCycleScheduler::Start(double startTime) {
+    if (!IsEnabled()) return;
+    
+    m_startTime = startTime;
+    for (uint32_t i = 0; i < m_devices.GetN(); ++i) {
+        // Every node is awake until its first window ends.
+        double firstSleep = startTime + Offset(i) + AwakeTime(i);
+        Simulator::Schedule(Seconds(firstSleep) - Simulator::Now(), &DutyCycleScheduler::Sleep, this, i);
+    }
+    
+    EventEmitter::Instance().EmitMetric("duty_cycle_sleep_ratio", m_sleepRatio);
+}
+
+void DutyCycleScheduler::Sleep(uint32_t nodeId) {
+    Ptr<WifiPhy> phy = GetPhy(m_devices, nodeId);
+    if (!phy || phy->IsStateOff()) return; // depleted: stop cycling
+    
+    // Wake at the start of the node's next period. The sleep ratio may have
+    // changed since this window opened: a longer window keeps the radio up
+    // until its new end, and wake-ups stay on the period grid either way.
+    double elapsed = Simulator::Now().GetSeconds() - m_startTime - Offset(nodeId);
+    double phase = std::fmod(std::max(0.0, elapsed), m_period);
+    double awake = AwakeTime(nodeId);
+    if (phase + 1e-9 < awake) {
+        Simulator::Schedule(Seconds(awake - phase), &DutyCycleScheduler::Sleep, this, nodeId);
+        return;
+    }
+    
+    phy->SetSleepMode();
+    Simulator::Schedule(Seconds(m_period - phase), &DutyCycleScheduler::Wake, this, nodeId);
+}
+
+void DutyCycleScheduler::Wake(uint32_t nodeId) {
+    Ptr<WifiPhy> phy = GetPhy(m_devices, nodeId);
+    if (!phy || phy->IsStateOff()) return;
+    
+    phy->ResumeFromSleep();
+    Simulator::Schedule(Seconds(AwakeTime(nodeId)), &DutyCycleScheduler::Sleep, this, nodeId);
+}
+
+bool DutyCycleScheduler::IsAwake(uint32_t nodeId) const {
+    return TimeUntilWake(nodeId) <= 0.0;
+}
+
+double DutyCycleScheduler::TimeUntilWake(uint32_t nodeId) const {
+    if (!IsEnabled()) return 0.0;
+    
+    double elapsed = Simulator::Now().GetSeconds() - m_startTime - Offset(nodeId);
+    double awake = AwakeTime(nodeId);
+    if (elapsed < awake) return 0.0; // includes the initial window
+    
+    double phase = std::fmod(elapsed, m_period);
+    return (phase < awake) ? 0.0 : m_period - phase;
+}
+
+double DutyCycleScheduler::TimeUntilRendezvous() const {
+    if (!IsEnabled()) return 0.0;
+    
+    // Every radio is up from the start until its first window ends
+    double elapsed = Simulator::Now().GetSeconds() - m_startTime;
+    if (elapsed < m_rendezvousEnd) return 0.0;
+    
+    double phase = std::fmod(elapsed, m_period);
+    if (phase < m_rendezvousStart) return m_rendezvousStart - phase;
+    if (phase < m_rendezvousEnd) return 0.0;
+    return m_period - phase + m_rendezvousStart;
+}
+
+void DutyCycleScheduler::RecordDeferral(uint32_t nodeId, double delay) {
+    (void)nodeId;
+    m_deferredPackets++;
+    m_totalDeferral += delay;
+    m_maxDeferral = std::max(m_maxDeferral, delay);
+}
+
+double DutyCycleScheduler::GetAverageAddedLatency() const {
+    return (m_deferredPackets > 0) ? m_totalDeferral / m_deferredPackets : 0.0;
+}
+
+double DutyCycleScheduler::GetSleepTime(const EnergyModelHelper& energy) const {
+    double total = 0.0;
+    for (uint32_t i = 0; i < m_devices.GetN(); ++i) {
+        total += energy.GetStateTime(i, EnergyModelHelper::Sleep);
+    }
+    return total;
+}
+
+double DutyCycleScheduler::GetEnergySaved(const EnergyModelHelper& energy) const {
+    const RadioHardwareProfile& profile = energy.GetProfile();
+    return GetSleepTime(energy) * (profile.idleCurrent - profile.sleepCurrent) * profile.supplyVoltage;
+}
+
+void DutyCycleScheduler::PrintReport(const EnergyModelHelper* energy) const {
+    if (!IsEnabled()) return;
+    
+    std::cout << "\n\033[1;33m😴 DUTY CYCLING (" 
+              << (m_mode == WakeMode::Staggered ? "staggered" : "synchronized") << "):\033[0m" << std::endl;
+    std::cout << "├─ Period / Awake:         " << std::fixed << std::setprecision(3)
+              << m_period << " s / " << m_awake << " s (sleep ratio "
+              << std::setprecision(2) << m_sleepRatio << ")" << std::endl;
+    std::cout << "├─ Rendezvous Window:      " << std::setprecision(3)
+              << std::max(0.0, m_rendezvousEnd - m_rendezvousStart) << " s per period" << std::endl;
+    if (energy) {
+        std::cout << "├─ Radio Sleep Time:       " << std::setprecision(1) << GetSleepTime(*energy)
+                  << " node-s" << std::endl;
+        std::cout << "├─ Energy Saved vs Idle:   " << std::setprecision(3) << GetEnergySaved(*energy)
+                  << " J" << std::endl;
+    }
+    std::cout << "├─ Packets Deferred:       " << m_deferredPackets << std::endl;
+    std::cout << "└─ Added Latency:          " << std::setprecision(4) << GetAverageAddedLatency()
+              << " s avg, " << m_maxDeferral << " s max" << std::endl;
+}
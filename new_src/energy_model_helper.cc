@@ -0,0 +1,222 @@
+#include "energy_model_helper.h"
+#include "ns3/energy-module.h"
+#include "ns3/wifi-module.h"
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+namespace {
+
+const RadioHardwareProfile kProfiles[] = {
+    // name     V     tx     rx     idle   cca    switch sleep
+    {"wifi",   3.0, 0.380, 0.313, 0.273, 0.273, 0.273, 0.033},
+    {"esp32",  3.3, 0.240, 0.100, 0.068, 0.100, 0.068, 0.0008},
+    {"cc2420", 3.0, 0.0174, 0.0188, 0.000426, 0.0188, 0.000426, 0.00002},
+};
+
+} // namespace
+
+bool RadioHardwareProfile::Lookup(const std::string& name, RadioHardwareProfile& profile) {
+    for (const RadioHardwareProfile& p : kProfiles) {
+        if (p.name == name) {
+            profile = p;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string RadioHardwareProfile::Names() {
+    std::string names;
+    for (const RadioHardwareProfile& p : kProfiles) {
+        if (!names.empty()) names += ", ";
+        names += p.name;
+    }
+    return names;
+}
+
+EnergyModelHelper::EnergyModelHelper(const RadioHardwareProfile& profile)
+    : m_profile(profile) {}
+
+void EnergyModelHelper::InstallEnergyModel(NodeContainer& nodes, NetDeviceContainer& devices,
+                                           double initialEnergy, double cutoffEnergy) {
+    BasicEnergySourceHelper energySourceHelper;
+    energySourceHelper.Set("BasicEnergySourceInitialEnergyJ", DoubleValue(initialEnergy));
+    energySourceHelper.Set("BasicEnergySupplyVoltageV", DoubleValue(m_profile.supplyVoltage));
+    energySourceHelper.Set("BasicEnergyLowBatteryThreshold",
+                           DoubleValue(initialEnergy > 0 ? cutoffEnergy / initialEnergy : 0.0));
+    
+    EnergySourceContainer energySources = energySourceHelper.Install(nodes);
+    
+    WifiRadioEnergyModelHelper radioEnergyHelper;
+    radioEnergyHelper.Set("TxCurrentA", DoubleValue(m_profile.txCurrent));
+    radioEnergyHelper.Set("RxCurrentA", DoubleValue(m_profile.rxCurrent));
+    radioEnergyHelper.Set("IdleCurrentA", DoubleValue(m_profile.idleCurrent));
+    radioEnergyHelper.Set("CcaBusyCurrentA", DoubleValue(m_profile.ccaBusyCurrent));
+    radioEnergyHelper.Set("SwitchingCurrentA", DoubleValue(m_profile.switchingCurrent));
+    radioEnergyHelper.Set("SleepCurrentA", DoubleValue(m_profile.sleepCurrent));
+    DeviceEnergyModelContainer radioModels = radioEnergyHelper.Install(devices, energySources);
+    
+    m_devices = devices;
+    m_stateTime.assign(devices.GetN(), std::array<double, StateCount>{});
+    m_lastLogged.assign(devices.GetN(), Simulator::Now().GetSeconds());
+    
+    for (uint32_t i = 0; i < devices.GetN(); ++i) {
+        Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(devices.Get(i));
+        if (!device) continue;
+        
+        device->GetPhy()->GetState()->TraceConnectWithoutContext("State",
+            MakeBoundCallback(&EnergyModelHelper::OnStateLogged, this, i));
+    }
+    
+    // Replaces the helper's default depletion action (radio off) with one
+    // that also reports the node
+    for (uint32_t i = 0; i < radioModels.GetN(); ++i) {
+        Ptr<WifiRadioEnergyModel> model = DynamicCast<WifiRadioEnergyModel>(radioModels.Get(i));
+        if (model) {
+            model->SetEnergyDepletionCallback(MakeBoundCallback(&EnergyModelHelper::OnDepleted, this, i));
+        }
+    }
+}
+
+double EnergyModelHelper::GetRemainingEnergy(NodeContainer& nodes, uint32_t nodeId) {
+    if (nodeId < nodes.GetN()) {
+        Ptr<EnergySource> source = nodes.Get(nodeId)->GetObject<EnergySource>();
+        if (source) {
+            return source->GetRemainingEnergy();
+        }
+    }
+    return 0.0;
+}
+
+void EnergyModelHelper::OnStateLogged(EnergyModelHelper* helper, uint32_t nodeId,
+                                      Time start, Time duration, WifiPhyState state) {
+    helper->AddStateTime(nodeId, FromPhyState(state), duration.GetSeconds());
+    helper->m_lastLogged[nodeId] = (start + duration).GetSeconds();
+}
+
+void EnergyModelHelper::OnDepleted(EnergyModelHelper* helper, uint32_t nodeId) {
+    Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(helper->m_devices.Get(nodeId));
+    if (device) {
+        device->GetPhy()->SetOffMode();
+    }
+    if (!helper->m_onDepleted.IsNull()) {
+        helper->m_onDepleted(nodeId);
+    }
+}
+
+void EnergyModelHelper::AddStateTime(uint32_t nodeId, RadioState state, double seconds) {
+    if (nodeId < m_stateTime.size()) {
+        m_stateTime[nodeId][state] += seconds;
+    }
+}
+
+void EnergyModelHelper::Finalize() {
+    double now = Simulator::Now().GetSeconds();
+    
+    for (uint32_t i = 0; i < m_devices.GetN(); ++i) {
+        Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(m_devices.Get(i));
+        if (!device || now <= m_lastLogged[i]) continue;
+        
+        AddStateTime(i, FromPhyState(device->GetPhy()->GetState()->GetState()), now - m_lastLogged[i]);
+        m_lastLogged[i] = now;
+    }
+}
+
+EnergyModelHelper::RadioState EnergyModelHelper::FromPhyState(WifiPhyState state) {
+    switch (state) {
+    case WifiPhyState::IDLE: return Idle;
+    case WifiPhyState::CCA_BUSY: return CcaBusy;
+    case WifiPhyState::TX: return Tx;
+    case WifiPhyState::RX: return Rx;
+    case WifiPhyState::SWITCHING: return Switching;
+    case WifiPhyState::SLEEP: return Sleep;
+    default: return Off;
+    }
+}
+
+const char* EnergyModelHelper::StateName(RadioState state) {
+    static const char* names[StateCount] = {"Idle", "CcaBusy", "Tx", "Rx", "Switching", "Sleep", "Off"};
+    return names[state];
+}
+
+double EnergyModelHelper::StateCurrent(RadioState state) const {
+    switch (state) {
+    case Idle: return m_profile.idleCurrent;
+    case CcaBusy: return m_profile.ccaBusyCurrent;
+    case Tx: return m_profile.txCurrent;
+    case Rx: return m_profile.rxCurrent;
+    case Switching: return m_profile.switchingCurrent;
+    case Sleep: return m_profile.sleepCurrent;
+    default: return 0.0;
+    }
+}
+
+double EnergyModelHelper::GetStateTime(uint32_t nodeId, RadioState state) const {
+    return (nodeId < m_stateTime.size()) ? m_stateTime[nodeId][state] : 0.0;
+}
+
+double EnergyModelHelper::GetStateEnergy(uint32_t nodeId, RadioState state) const {
+    return GetStateTime(nodeId, state) * StateCurrent(state) * m_profile.supplyVoltage;
+}
+
+double EnergyModelHelper::GetTotalStateEnergy(RadioState state) const {
+    double total = 0.0;
+    for (uint32_t i = 0; i < m_stateTime.size(); ++i) {
+        total += GetStateEnergy(i, state);
+    }
+    return total;
+}
+
+void EnergyModelHelper::PrintEnergyBreakdown() const {
+    double total = 0.0;
+    for (int s = 0; s < StateCount; ++s) {
+        total += GetTotalStateEnergy(static_cast<RadioState>(s));
+    }
+    
+    std::cout << "\n\033[1;33m🔋 RADIO ENERGY BY STATE (" << m_profile.name << " profile):\033[0m" << std::endl;
+    for (int s = 0; s < StateCount; ++s) {
+        RadioState state = static_cast<RadioState>(s);
+        double energy = GetTotalStateEnergy(state);
+        if (energy <= 0.0 && state != Tx && state != Rx) continue;
+        
+        std::cout << "├─ " << std::left << std::setw(10) << StateName(state) << std::right
+                  << std::fixed << std::setprecision(3) << std::setw(10) << energy << " J ("
+                  << std::setprecision(1) << (total > 0 ? energy / total * 100.0 : 0.0) << "%)" << std::endl;
+    }
+    std::cout << "└─ Total:    " << std::fixed << std::setprecision(3) << std::setw(10) << total
+              << " J" << std::endl;
+}
+
+void EnergyModelHelper::ExportEnergyBreakdown(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        return;
+    }
+    
+    file << "NodeID";
+    for (int s = 0; s < StateCount; ++s) {
+        file << "," << StateName(static_cast<RadioState>(s)) << "Time";
+    }
+    for (int s = 0; s < StateCount; ++s) {
+        file << "," << StateName(static_cast<RadioState>(s)) << "Energy";
+    }
+    file << "\n";
+    
+    for (uint32_t i = 0; i < m_stateTime.size(); ++i) {
+        file << i;
+        for (int s = 0; s < StateCount; ++s) {
+            file << "," << std::fixed << std::setprecision(6) << m_stateTime[i][s];
+        }
+        for (int s = 0; s < StateCount; ++s) {
+            file << "," << GetStateEnergy(i, static_cast<RadioState>(s));
+        }
+        file << "\n";
+    }
+    
+    file.close();
+    std::cout << "Radio energy breakdown exported to: " << filename << std::endl;
+}
@@ -1,68 +1,159 @@
 #include "event_emitter.h"
+#include "telemetry_sink.h"
+#include "event_log.h"
+#include "ns3/simulator.h"
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 
-void EventEmitter::EmitEvent(const std::string& event, uint32_t packetId, int from, int to) {
-    std::lock_guard<std::mutex> lock(mtx);
+namespace {
+
+int64_t WallClockMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+void EventEmitter::WriteTimeFields(std::ostream& os) {
+    // Simulation time is free to read and is what consumers order/replay by.
+    os << "\"time\":" << std::fixed << std::setprecision(6)
+       << ns3::Simulator::Now().GetSeconds();
+    
+    if (timestampMode == TimestampMode::SimTimeWithWallClock) {
+        // Only hit the system clock once every N events; in between the
+        // cached value is reused, which is plenty for profiling.
+        if (eventsSinceWallClockRefresh == 0) {
+            cachedWallClockMs = WallClockMs();
+        }
+        if (++eventsSinceWallClockRefresh >= wallClockRefreshEvents) {
+            eventsSinceWallClockRefresh = 0;
+        }
+        os << ",\"timestamp\":" << cachedWallClockMs;
+    }
+}
+
+std::ostringstream& EventEmitter::BeginLine() {
+    lineBuffer.str(std::string());
+    lineBuffer.clear();
+    lineBuffer << "{";
+    WriteTimeFields(lineBuffer);
+    return lineBuffer;
+}
+
+void EventEmitter::PublishLine() {
+    const std::string line = lineBuffer.str();
     
-    auto now = std::chrono::system_clock::now();
-    auto now_c = std::chrono::system_clock::to_time_t(now);
+    if (stdoutEnabled) {
+        std::cout << line << std::endl;
+    }
+    if (telemetrySink || eventLog) {
+        double simTime = ns3::Simulator::Now().GetSeconds();
+        if (telemetrySink) telemetrySink->PublishEvent(line, simTime);
+        if (eventLog) eventLog->Append(line, simTime);
+    }
+}
+
+void EventEmitter::PublishRaw(const std::string& line, double simTime) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     
-    std::cout << "{"
-              << "\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(
-                  now.time_since_epoch()).count() << ","
-              << "\"time\":" << std::fixed << std::setprecision(3) << simulationStartTime << ","
-              << "\"event\":\"" << event << "\","
-              << "\"packetId\":" << packetId;
+    if (stdoutEnabled) {
+        std::cout << line << '\n';
+    }
+    if (telemetrySink) telemetrySink->PublishEvent(line, simTime);
+    if (eventLog) eventLog->Append(line, simTime);
+}
+
+void EventEmitter::AttachTelemetrySink(TelemetrySink* sink, bool keepStdout) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    telemetrySink = sink;
+    stdoutEnabled = (sink == nullptr) || keepStdout;
+}
+
+void EventEmitter::AttachEventLog(EventLogWriter* log) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    eventLog = log;
+}
+
+void EventEmitter::EmitEvent(const std::string& event, uint32_t packetId, int from, int to) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    
+    std::ostringstream& line = BeginLine();
+    line << ","
+         << "\"event\":\"" << event << "\","
+         << "\"packetId\":" << packetId;
     
     if (from >= 0)
-        std::cout << ",\"from\":" << from;
+        line << ",\"from\":" << from;
     if (to >= 0)
-        std::cout << ",\"to\":" << to;
+        line << ",\"to\":" << to;
     
-    std::cout << "}" << std::endl;
+    line << "}";
+    PublishLine();
 }
 
 void EventEmitter::EmitNodeEvent(uint32_t nodeId, const std::string& status, double energy) {
-    std::lock_guard<std::mutex> lock(mtx);
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     
-    std::cout << "{"
-              << "\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(
-                  std::chrono::system_clock::now().time_since_epoch()).count() << ","
-              << "\"type\":\"node_event\","
-              << "\"nodeId\":" << nodeId << ","
-              << "\"status\":\"" << status << "\"";
+    std::ostringstream& line = BeginLine();
+    line << ","
+         << "\"type\":\"node_event\","
+         << "\"nodeId\":" << nodeId << ","
+         << "\"status\":\"" << status << "\"";
     
     if (energy >= 0)
-        std::cout << ",\"energy\":" << std::fixed << std::setprecision(3) << energy;
+        line << ",\"energy\":" << std::fixed << std::setprecision(3) << energy;
     
-    std::cout << "}" << std::endl;
+    line << "}";
+    PublishLine();
 }
 
 void EventEmitter::EmitMetric(const std::string& metric, double value, const std::string& unit) {
-    std::lock_guard<std::mutex> lock(mtx);
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     metrics[metric].push_back(value);
     
-    std::cout << "{"
-              << "\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(
-                  std::chrono::system_clock::now().time_since_epoch()).count() << ","
-              << "\"type\":\"metric\","
-              << "\"metric\":\"" << metric << "\","
-              << "\"value\":" << std::fixed << std::setprecision(6) << value;
+    std::ostringstream& line = BeginLine();
+    line << ","
+         << "\"type\":\"metric\","
+         << "\"metric\":\"" << metric << "\","
+         << "\"value\":" << std::fixed << std::setprecision(6) << value;
     
     if (!unit.empty())
-        std::cout << ",\"unit\":\"" << unit << "\"";
+        line << ",\"unit\":\"" << unit << "\"";
     
-    std::cout << "}" << std::endl;
+    line << "}";
+    PublishLine();
+}
+
+void EventEmitter::EmitFrame(uint64_t frameId, const std::string& nodesJson, size_t changedNodes) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    
+    std::ostringstream& line = BeginLine();
+    line << ","
+         << "\"type\":\"frame\","
+         << "\"frame\":" << frameId << ","
+         << "\"changed\":" << changedNodes << ","
+         << "\"nodes\":" << nodesJson
+         << "}";
+    PublishLine();
 }
 
 void EventEmitter::SetSimulationStartTime() {
-    simulationStartTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count() / 1000.0;
+    // Wall-clock start of the run, kept for profiling/reporting only; event
+    // "time" fields always carry simulation time.
+    simulationStartTime = WallClockMs() / 1000.0;
+}
+
+void EventEmitter::SetTimestampMode(TimestampMode mode, uint32_t wallClockRefresh) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+    timestampMode = mode;
+    wallClockRefreshEvents = std::max<uint32_t>(1, wallClockRefresh);
+    eventsSinceWallClockRefresh = 0;
+    cachedWallClockMs = 0;
 }
 
 void EventEmitter::LogNodeDeath(uint32_t nodeId, double deathTime, const std::string& cause) {
-    std::lock_guard<std::mutex> lock(mtx);
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     
     nodeDeaths.push_back({nodeId, deathTime});
     
@@ -75,18 +166,18 @@ void EventEmitter::LogNodeDeath(uint32_t nodeId, double deathTime, const std::st
     EmitNodeEvent(nodeId, "dead", 0.0);
     EmitEvent("node_death", nodeId, nodeId, -1);
     
-    std::cout << "{"
-              << "\"timestamp\":" << std::chrono::duration_cast<std::chrono::milliseconds>(
-                  std::chrono::system_clock::now().time_since_epoch()).count() << ","
-              << "\"type\":\"node_death\","
-              << "\"nodeId\":" << nodeId << ","
-              << "\"deathTime\":" << std::fixed << std::setprecision(3) << deathTime << ","
-              << "\"cause\":\"" << cause << "\""
-              << "}" << std::endl;
+    std::ostringstream& line = BeginLine();
+    line << ","
+         << "\"type\":\"node_death\","
+         << "\"nodeId\":" << nodeId << ","
+         << "\"deathTime\":" << std::fixed << std::setprecision(3) << deathTime << ","
+         << "\"cause\":\"" << cause << "\""
+         << "}";
+    PublishLine();
 }
 
 void EventEmitter::PrintDeathStatistics() const {
-    std::lock_guard<std::mutex> lock(mtx);
+    std::lock_guard<std::recursive_mutex> lock(mtx);
     
     if (nodeDeaths.empty()) {
         std::cout << "\033[1;32mNo node deaths recorded.\033[0m" << std::endl;
@@ -0,0 +1,287 @@
+#include "event_log.h"
+#include "lz_codec.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+const char kLogMagic[8] = {'W', 'S', 'N', 'E', 'V', 'L', 'G', '1'};
+const char kIndexMagic[8] = {'W', 'S', 'N', 'E', 'V', 'I', 'X', '1'};
+const uint32_t kBlockMagic = 0x314B4C42; // "BLK1"
+const uint32_t kBlockStored = 0x1;
+
+uint32_t Fnv1a(const uint8_t* data, size_t n) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; ++i) {
+        h ^= data[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+} // namespace
+
+bool ExtractEventTime(const std::string& line, double& time) {
+    size_t pos = line.find("\"time\":");
+    if (pos == std::string::npos) return false;
+
+    const char* start = line.c_str() + pos + 7;
+    char* end = nullptr;
+    time = std::strtod(start, &end);
+    return end != start;
+}
+
+// ---------------------------------------------------------------------------
+// Writer
+// ---------------------------------------------------------------------------
+
+EventLogWriter::EventLogWriter()
+    : blockSize(64 * 1024), blockEvents(0), blockFirstTime(0.0), blockLastTime(0.0),
+      offset(0), rawBytes(0), compressedBytes(0) {}
+
+EventLogWriter::~EventLogWriter() {
+    Close();
+}
+
+bool EventLogWriter::Open(const std::string& path, size_t size) {
+    Close();
+
+    log.open(path, std::ios::binary | std::ios::trunc);
+    index.open(path + ".idx", std::ios::binary | std::ios::trunc);
+    if (!log.is_open() || !index.is_open()) {
+        std::cerr << "Error opening event log: " << path << std::endl;
+        log.close();
+        index.close();
+        return false;
+    }
+
+    uint32_t version = 1;
+    uint32_t size32 = static_cast<uint32_t>(size);
+    log.write(kLogMagic, sizeof(kLogMagic));
+    log.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    log.write(reinterpret_cast<const char*>(&size32), sizeof(size32));
+    index.write(kIndexMagic, sizeof(kIndexMagic));
+    index.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    index.write(reinterpret_cast<const char*>(&size32), sizeof(size32));
+
+    blockSize = size;
+    block.clear();
+    block.reserve(blockSize + 1024);
+    blockEvents = 0;
+    offset = sizeof(kLogMagic) + 2 * sizeof(uint32_t);
+    rawBytes = 0;
+    compressedBytes = 0;
+    return true;
+}
+
+void EventLogWriter::Append(const std::string& line, double simTime) {
+    if (!log.is_open()) return;
+
+    if (blockEvents == 0) {
+        blockFirstTime = simTime;
+        blockLastTime = simTime;
+    }
+    blockLastTime = std::max(blockLastTime, simTime);
+    blockEvents++;
+
+    block.append(line);
+    block.push_back('\n');
+
+    if (block.size() >= blockSize) {
+        FlushBlock();
+    }
+}
+
+void EventLogWriter::FlushBlock() {
+    if (blockEvents == 0) return;
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(block.data());
+    scratch.clear();
+    LzCodec::Compress(data, block.size(), scratch);
+
+    EventLogBlockHeader header;
+    header.magic = kBlockMagic;
+    header.flags = 0;
+    header.rawSize = static_cast<uint32_t>(block.size());
+    header.eventCount = blockEvents;
+    header.checksum = Fnv1a(data, block.size());
+    header.firstTime = blockFirstTime;
+    header.lastTime = blockLastTime;
+
+    const char* payload = reinterpret_cast<const char*>(scratch.data());
+    if (scratch.size() >= block.size()) {
+        header.flags |= kBlockStored;
+        payload = block.data();
+        header.compressedSize = header.rawSize;
+    } else {
+        header.compressedSize = static_cast<uint32_t>(scratch.size());
+    }
+
+    log.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    log.write(payload, header.compressedSize);
+
+    EventLogIndexEntry entry;
+    entry.firstTime = header.firstTime;
+    entry.lastTime = header.lastTime;
+    entry.offset = offset;
+    entry.compressedSize = header.compressedSize;
+    entry.rawSize = header.rawSize;
+    entry.eventCount = header.eventCount;
+    entry.reserved = 0;
+    index.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    index.flush();
+
+    offset += sizeof(header) + header.compressedSize;
+    rawBytes += header.rawSize;
+    compressedBytes += sizeof(header) + header.compressedSize;
+
+    block.clear();
+    blockEvents = 0;
+}
+
+void EventLogWriter::Close() {
+    if (!log.is_open()) return;
+
+    FlushBlock();
+    log.close();
+    index.close();
+}
+
+// ---------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------
+
+bool EventLogReader::Open(const std::string& path) {
+    log.close();
+    log.clear();
+    index.clear();
+    blockLoaded = false;
+    nextBlock = 0;
+    cursor = 0;
+    seekTime = -1.0;
+
+    log.open(path, std::ios::binary);
+    if (!log.is_open()) return false;
+
+    char magic[8];
+    if (!log.read(magic, sizeof(magic)) || memcmp(magic, kLogMagic, sizeof(magic)) != 0) {
+        std::cerr << "Not an event log: " << path << std::endl;
+        return false;
+    }
+
+    if (!LoadIndex(path + ".idx")) {
+        return RebuildIndex();
+    }
+    return true;
+}
+
+bool EventLogReader::LoadIndex(const std::string& indexPath) {
+    std::ifstream in(indexPath, std::ios::binary);
+    char magic[8];
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, kIndexMagic, sizeof(magic)) != 0) {
+        return false;
+    }
+    in.seekg(2 * sizeof(uint32_t), std::ios::cur);
+
+    EventLogIndexEntry entry;
+    while (in.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+        index.push_back(entry);
+    }
+    return true;
+}
+
+bool EventLogReader::RebuildIndex() {
+    uint64_t pos = sizeof(kLogMagic) + 2 * sizeof(uint32_t);
+    EventLogBlockHeader header;
+
+    log.clear();
+    log.seekg(pos);
+    while (log.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        if (header.magic != kBlockMagic) break;
+
+        EventLogIndexEntry entry;
+        entry.firstTime = header.firstTime;
+        entry.lastTime = header.lastTime;
+        entry.offset = pos;
+        entry.compressedSize = header.compressedSize;
+        entry.rawSize = header.rawSize;
+        entry.eventCount = header.eventCount;
+        entry.reserved = 0;
+        index.push_back(entry);
+
+        pos += sizeof(header) + header.compressedSize;
+        log.seekg(pos);
+    }
+    log.clear();
+    return true;
+}
+
+bool EventLogReader::LoadBlock(size_t blockIndex) {
+    blockLoaded = false;
+    if (blockIndex >= index.size()) return false;
+
+    const EventLogIndexEntry& entry = index[blockIndex];
+    EventLogBlockHeader header;
+
+    log.clear();
+    log.seekg(entry.offset);
+    if (!log.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != kBlockMagic) {
+        std::cerr << "Corrupt event log block " << blockIndex << std::endl;
+        return false;
+    }
+
+    payload.resize(header.compressedSize);
+    if (!log.read(reinterpret_cast<char*>(payload.data()), payload.size())) return false;
+
+    if (header.flags & kBlockStored) {
+        raw.swap(payload);
+    } else if (!LzCodec::Decompress(payload.data(), payload.size(), header.rawSize, raw)) {
+        std::cerr << "Corrupt event log block " << blockIndex << std::endl;
+        return false;
+    }
+
+    if (Fnv1a(raw.data(), raw.size()) != header.checksum) {
+        std::cerr << "Checksum mismatch in event log block " << blockIndex << std::endl;
+        return false;
+    }
+
+    cursor = 0;
+    blockLoaded = true;
+    return true;
+}
+
+bool EventLogReader::Seek(double t) {
+    // First block whose time range reaches t.
+    auto it = std::lower_bound(index.begin(), index.end(), t,
+        [](const EventLogIndexEntry& entry, double time) { return entry.lastTime < time; });
+
+    seekTime = t;
+    blockLoaded = false;
+    nextBlock = static_cast<size_t>(it - index.begin());
+    return it != index.end();
+}
+
+bool EventLogReader::Next(std::string& line, double& time) {
+    while (true) {
+        if (!blockLoaded || cursor >= raw.size()) {
+            if (!LoadBlock(nextBlock)) return false;
+            nextBlock++;
+        }
+
+        const char* begin = reinterpret_cast<const char*>(raw.data()) + cursor;
+        const void* newline = memchr(begin, '\n', raw.size() - cursor);
+        size_t length = newline ? static_cast<const char*>(newline) - begin : raw.size() - cursor;
+
+        line.assign(begin, length);
+        cursor += length + 1;
+
+        if (!ExtractEventTime(line, time)) time = 0.0;
+        if (seekTime >= 0.0) {
+            if (time < seekTime) continue;
+            seekTime = -1.0;
+        }
+        return true;
+    }
+}
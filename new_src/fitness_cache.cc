@@ -0,0 +1,170 @@
+#include "fitness_cache.h"
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstring>
+
+namespace {
+const char kMagic[8] = {'W', 'S', 'N', 'F', 'C', 'A', 'C', '1'};
+const uint32_t kMaxValues = 64;
+}
+
+FitnessCache::FitnessCache(FitnessEvaluator* evaluator, uint64_t context, double step)
+    : inner(evaluator), contextHash(context), quantum(step > 0 ? step : 1e-3),
+      loadedEntries(0), lookups(0), hits(0) {}
+
+FitnessCache::~FitnessCache() {
+    Close();
+}
+
+uint64_t FitnessCache::Hash(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    uint64_t h = seed;
+    for (size_t i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+uint64_t FitnessCache::Key(uint64_t context, const std::vector<double>& params) const {
+    uint64_t h = Hash(&context, sizeof(context));
+    for (double value : params) {
+        int64_t q = (int64_t)std::llround(value / quantum);
+        h = Hash(&q, sizeof(q), h);
+    }
+    return h;
+}
+
+bool FitnessCache::Open(const std::string& filePath) {
+    Close();
+    path = filePath;
+    
+    std::ifstream in(path, std::ios::binary);
+    bool valid = false;
+    bool torn = false;
+    if (in) {
+        char magic[sizeof(kMagic)];
+        valid = in.read(magic, sizeof(magic)) && memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+        if (!valid) {
+            std::cerr << "Fitness cache: " << path << " is not a cache file, starting a new one" << std::endl;
+        }
+        
+        FitnessCacheRecord record;
+        std::vector<double> values;
+        while (valid && in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+            if (record.valueCount > kMaxValues) {
+                torn = true;
+                break;
+            }
+            values.resize(record.valueCount);
+            if (!in.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(double))) {
+                torn = true;
+                break;
+            }
+            entries[record.key] = values;
+            loadedEntries++;
+        }
+        if (valid && in.gcount() != 0 && in.gcount() != (std::streamsize)sizeof(record)) {
+            torn = true;
+        }
+    }
+    in.close();
+    
+    // Rewrite from memory when the file is new, foreign or has a torn tail,
+    // so appends always land on a record boundary
+    if (valid && !torn) {
+        file.open(path, std::ios::binary | std::ios::app);
+    } else {
+        file.open(path, std::ios::binary | std::ios::trunc);
+        file.write(kMagic, sizeof(kMagic));
+        for (const auto& entry : entries) {
+            FitnessCacheRecord record{entry.first, (uint32_t)entry.second.size(), 0};
+            file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+            file.write(reinterpret_cast<const char*>(entry.second.data()), entry.second.size() * sizeof(double));
+        }
+        file.flush();
+    }
+    
+    if (!file) {
+        std::cerr << "Fitness cache: cannot write " << path << ", keeping entries in memory" << std::endl;
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+void FitnessCache::Close() {
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+bool FitnessCache::Lookup(uint64_t context, const std::vector<double>& params, std::vector<double>& values) {
+    lookups++;
+    auto it = entries.find(Key(context, params));
+    if (it == entries.end()) return false;
+    hits++;
+    values = it->second;
+    return true;
+}
+
+void FitnessCache::Insert(uint64_t context, const std::vector<double>& params, const std::vector<double>& values) {
+    uint64_t key = Key(context, params);
+    entries[key] = values;
+    
+    if (file.is_open()) {
+        FitnessCacheRecord record{key, (uint32_t)values.size(), 0};
+        file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+    }
+}
+
+void FitnessCache::Evaluate(const std::vector<std::vector<double>>& candidates,
+                            std::vector<double>& fitness) {
+    fitness.resize(candidates.size());
+    
+    std::vector<std::vector<double>> misses;
+    std::vector<size_t> missIndex;
+    std::vector<double> values;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (Lookup(contextHash, candidates[i], values) && !values.empty()) {
+            fitness[i] = values[0];
+        } else {
+            misses.push_back(candidates[i]);
+            missIndex.push_back(i);
+        }
+    }
+    
+    if (misses.empty() || !inner) return;
+    
+    std::vector<double> missFitness;
+    inner->Evaluate(misses, missFitness);
+    for (size_t m = 0; m < misses.size(); m++) {
+        fitness[missIndex[m]] = missFitness[m];
+        
+        // Zero is what a failed evaluation scores; let it be retried
+        if (missFitness[m] > 0.0) {
+            Insert(contextHash, misses[m], {missFitness[m]});
+        }
+    }
+    
+    // One flush per batch: a crash loses at most the batch in flight
+    if (file.is_open()) {
+        file.flush();
+    }
+}
+
+std::string FitnessCache::GetName() const {
+    return inner ? "cached " + inner->GetName() : "cached";
+}
+
+void FitnessCache::PrintReport() const {
+    std::cout << "\n\033[1;33m🗃️  FITNESS CACHE:\033[0m" << std::endl;
+    std::cout << "├─ File:                   " << (path.empty() ? "(memory only)" : path) << std::endl;
+    std::cout << "├─ Entries:                " << entries.size() << " (" << loadedEntries
+              << " loaded)" << std::endl;
+    std::cout << "├─ Lookups:                " << lookups << std::endl;
+    std::cout << "└─ Hit Rate:               " << std::fixed << std::setprecision(1)
+              << GetHitRate() << "% (" << hits << " hits)" << std::endl;
+}
@@ -0,0 +1,104 @@
+#include "frame_emitter.h"
+#include "event_emitter.h"
+#include "telemetry_sink.h"
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+
+void FrameEmitter::Configure(uint32_t nodeCount, double tickSeconds, double resolution) {
+    tickInterval = tickSeconds;
+    energyResolution = resolution;
+    
+    nodes.assign(nodeCount, NodeFrameState{-1.0, -1.0, "", "", false});
+    dirtyNodes.clear();
+    dirtyNodes.reserve(nodeCount);
+}
+
+void FrameEmitter::Start() {
+    if (!IsEnabled()) return;
+    tickEvent = ns3::Simulator::Schedule(ns3::Seconds(tickInterval), &FrameEmitter::Tick, this);
+}
+
+void FrameEmitter::Stop() {
+    ns3::Simulator::Cancel(tickEvent);
+}
+
+void FrameEmitter::MarkDirty(uint32_t nodeId) {
+    if (!nodes[nodeId].dirty) {
+        nodes[nodeId].dirty = true;
+        dirtyNodes.push_back(nodeId);
+    }
+}
+
+void FrameEmitter::UpdateEnergy(uint32_t nodeId, double energy) {
+    if (nodeId >= nodes.size()) return;
+    
+    updatesReceived++;
+    nodes[nodeId].energy = energy;
+    MirrorToTelemetry(nodeId);
+    
+    if (IsEnabled() && std::fabs(energy - nodes[nodeId].sentEnergy) >= energyResolution) {
+        MarkDirty(nodeId);
+    }
+}
+
+void FrameEmitter::UpdateStatus(uint32_t nodeId, const std::string& status) {
+    if (nodeId >= nodes.size()) return;
+    
+    updatesReceived++;
+    nodes[nodeId].status = status;
+    MirrorToTelemetry(nodeId);
+    
+    if (IsEnabled() && status != nodes[nodeId].sentStatus) {
+        MarkDirty(nodeId);
+    }
+}
+
+void FrameEmitter::MirrorToTelemetry(uint32_t nodeId) {
+    // The shared-memory node table always holds the latest state, independent
+    // of the frame tick.
+    TelemetrySink* sink = EventEmitter::Instance().GetTelemetrySink();
+    if (sink) {
+        sink->UpdateNode(nodeId, nodes[nodeId].energy, nodes[nodeId].status != "dead",
+                         ns3::Simulator::Now().GetSeconds());
+    }
+}
+
+void FrameEmitter::Flush() {
+    if (dirtyNodes.empty()) return;
+    
+    std::ostringstream body;
+    body << std::fixed << std::setprecision(3) << "[";
+    
+    size_t written = 0;
+    for (uint32_t nodeId : dirtyNodes) {
+        NodeFrameState& state = nodes[nodeId];
+        state.dirty = false;
+        
+        bool energyChanged = std::fabs(state.energy - state.sentEnergy) >= energyResolution;
+        bool statusChanged = state.status != state.sentStatus;
+        if (!energyChanged && !statusChanged) continue;
+        
+        body << (written++ ? "," : "") << "{\"id\":" << nodeId;
+        if (energyChanged) {
+            body << ",\"energy\":" << state.energy;
+            state.sentEnergy = state.energy;
+        }
+        if (statusChanged) {
+            body << ",\"status\":\"" << state.status << "\"";
+            state.sentStatus = state.status;
+        }
+        body << "}";
+    }
+    body << "]";
+    dirtyNodes.clear();
+    
+    if (written == 0) return;
+    
+    EventEmitter::Instance().EmitFrame(framesEmitted++, body.str(), written);
+}
+
+void FrameEmitter::Tick() {
+    Flush();
+    tickEvent = ns3::Simulator::Schedule(ns3::Seconds(tickInterval), &FrameEmitter::Tick, this);
+}
@@ -0,0 +1,207 @@
+#include "gaussian_process.h"
+#include "sobol_sequence.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+const double kDefaultLengthScale = 0.3;
+const double kDefaultNoise = 1e-4;
+const double kMinLengthScale = 0.03;
+const double kMaxLengthScale = 3.0;
+const double kMinNoise = 1e-6;
+const double kMaxNoise = 0.3;
+
+// Added to the diagonal on top of the fitted noise for numerical safety
+const double kJitter = 1e-9;
+
+double LogUniform(double u, double lo, double hi) {
+    return std::exp(std::log(lo) + u * (std::log(hi) - std::log(lo)));
+}
+}
+
+GaussianProcess::GaussianProcess()
+    : targetMean(0.0), targetScale(1.0), noise(kDefaultNoise),
+      logLikelihood(-std::numeric_limits<double>::infinity()) {}
+
+double GaussianProcess::Kernel(const std::vector<double>& a, const std::vector<double>& b,
+                               const std::vector<double>& scales) const {
+    double distance = 0.0;
+    for (size_t d = 0; d < a.size(); d++) {
+        double r = (a[d] - b[d]) / scales[d];
+        distance += r * r;
+    }
+    return std::exp(-0.5 * distance);
+}
+
+double GaussianProcess::Factorize(const std::vector<double>& scales, double noiseVariance,
+                                  std::vector<double>& factor, std::vector<double>& weights) const {
+    size_t n = inputs.size();
+    factor.assign(n * n, 0.0);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j <= i; j++) {
+            factor[i * n + j] = Kernel(inputs[i], inputs[j], scales);
+        }
+        factor[i * n + i] += noiseVariance + kJitter;
+    }
+    
+    // In-place Cholesky, lower triangle
+    double logDeterminant = 0.0;
+    for (size_t j = 0; j < n; j++) {
+        double pivot = factor[j * n + j];
+        for (size_t k = 0; k < j; k++) {
+            pivot -= factor[j * n + k] * factor[j * n + k];
+        }
+        if (!(pivot > 0.0)) {
+            return -std::numeric_limits<double>::infinity();
+        }
+        double diagonal = std::sqrt(pivot);
+        factor[j * n + j] = diagonal;
+        logDeterminant += 2.0 * std::log(diagonal);
+        for (size_t i = j + 1; i < n; i++) {
+            double value = factor[i * n + j];
+            for (size_t k = 0; k < j; k++) {
+                value -= factor[i * n + k] * factor[j * n + k];
+            }
+            factor[i * n + j] = value / diagonal;
+        }
+    }
+    
+    // weights = L^-T L^-1 targets
+    weights = targets;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t k = 0; k < i; k++) {
+            weights[i] -= factor[i * n + k] * weights[k];
+        }
+        weights[i] /= factor[i * n + i];
+    }
+    double fit = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        fit += weights[i] * weights[i];
+    }
+    for (size_t i = n; i-- > 0;) {
+        for (size_t k = i + 1; k < n; k++) {
+            weights[i] -= factor[k * n + i] * weights[k];
+        }
+        weights[i] /= factor[i * n + i];
+    }
+    
+    const double kLog2Pi = std::log(2.0 * M_PI);
+    return -0.5 * fit - 0.5 * logDeterminant - 0.5 * n * kLog2Pi;
+}
+
+bool GaussianProcess::SetData(const std::vector<std::vector<double>>& x, const std::vector<double>& y) {
+    inputs = x;
+    size_t n = std::min(x.size(), y.size());
+    inputs.resize(n);
+    
+    targetMean = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        targetMean += y[i];
+    }
+    targetMean = n > 0 ? targetMean / n : 0.0;
+    double variance = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        variance += (y[i] - targetMean) * (y[i] - targetMean);
+    }
+    targetScale = n > 1 ? std::sqrt(variance / (n - 1)) : 0.0;
+    if (!(targetScale > 1e-12)) {
+        targetScale = 1.0;
+    }
+    
+    targets.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        targets[i] = (y[i] - targetMean) / targetScale;
+    }
+    
+    if (lengthScales.size() != (n > 0 ? inputs[0].size() : 0)) {
+        lengthScales.assign(n > 0 ? inputs[0].size() : 0, kDefaultLengthScale);
+        noise = kDefaultNoise;
+    }
+    logLikelihood = Factorize(lengthScales, noise, cholesky, alpha);
+    return std::isfinite(logLikelihood);
+}
+
+bool GaussianProcess::AddObservation(const std::vector<double>& x, double y) {
+    inputs.push_back(x);
+    targets.push_back((y - targetMean) / targetScale);
+    logLikelihood = Factorize(lengthScales, noise, cholesky, alpha);
+    return std::isfinite(logLikelihood);
+}
+
+bool GaussianProcess::FitHyperparameters(uint32_t trials) {
+    if (inputs.empty()) return false;
+    
+    size_t dimensions = inputs[0].size();
+    std::vector<double> bestScales = lengthScales;
+    double bestNoise = noise;
+    double best = Factorize(lengthScales, noise, cholesky, alpha);
+    
+    SobolSequence sequence((uint32_t)(dimensions + 1));
+    std::vector<double> point;
+    std::vector<double> scales(dimensions);
+    std::vector<double> factor;
+    std::vector<double> weights;
+    for (uint32_t t = 0; t < trials; t++) {
+        sequence.Next(point);
+        for (size_t d = 0; d < dimensions; d++) {
+            scales[d] = LogUniform(point[d % point.size()], kMinLengthScale, kMaxLengthScale);
+        }
+        double trialNoise = LogUniform(point[dimensions % point.size()], kMinNoise, kMaxNoise);
+        double likelihood = Factorize(scales, trialNoise, factor, weights);
+        if (likelihood > best) {
+            best = likelihood;
+            bestScales = scales;
+            bestNoise = trialNoise;
+        }
+    }
+    
+    lengthScales = bestScales;
+    noise = bestNoise;
+    logLikelihood = Factorize(lengthScales, noise, cholesky, alpha);
+    return std::isfinite(logLikelihood);
+}
+
+void GaussianProcess::Predict(const std::vector<double>& x, double& mean, double& stddev) const {
+    size_t n = inputs.size();
+    if (n == 0 || !std::isfinite(logLikelihood)) {
+        mean = targetMean;
+        stddev = targetScale;
+        return;
+    }
+    
+    std::vector<double> v(n);
+    double m = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        v[i] = Kernel(x, inputs[i], lengthScales);
+        m += v[i] * alpha[i];
+    }
+    
+    // Variance reduction: |L^-1 k*|^2
+    double explained = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t k = 0; k < i; k++) {
+            v[i] -= cholesky[i * n + k] * v[k];
+        }
+        v[i] /= cholesky[i * n + i];
+        explained += v[i] * v[i];
+    }
+    
+    mean = targetMean + targetScale * m;
+    stddev = targetScale * std::sqrt(std::max(0.0, 1.0 - explained));
+}
+
+double GaussianProcess::ExpectedImprovement(const std::vector<double>& x, double best) const {
+    double mean;
+    double stddev;
+    Predict(x, mean, stddev);
+    
+    double gain = mean - best;
+    if (stddev < 1e-12 * targetScale) {
+        return std::max(0.0, gain);
+    }
+    double z = gain / stddev;
+    double cdf = 0.5 * std::erfc(-z / std::sqrt(2.0));
+    double pdf = std::exp(-0.5 * z * z) / std::sqrt(2.0 * M_PI);
+    return gain * cdf + stddev * pdf;
+}
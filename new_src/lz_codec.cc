@@ -0,0 +1,161 @@
+#include "lz_codec.h"
+#include <cstring>
+
+namespace {
+
+const size_t kMinMatch = 4;
+const size_t kLastLiterals = 5;   // the block always ends with >= 5 literals
+const size_t kMatchLimit = 12;    // no match may start within 12 bytes of the end
+const size_t kMaxOffset = 65535;
+const int kHashBits = 14;
+
+uint32_t Read32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint32_t Hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+void WriteLength(std::vector<uint8_t>& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+void EmitSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalLength,
+                  size_t offset, size_t matchLength) {
+    size_t matchCode = matchLength - kMinMatch;
+    uint8_t token = static_cast<uint8_t>((literalLength >= 15 ? 15 : literalLength) << 4);
+    token |= static_cast<uint8_t>(matchCode >= 15 ? 15 : matchCode);
+    out.push_back(token);
+
+    if (literalLength >= 15) WriteLength(out, literalLength - 15);
+    out.insert(out.end(), literals, literals + literalLength);
+
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15) WriteLength(out, matchCode - 15);
+}
+
+void EmitLastLiterals(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalLength) {
+    out.push_back(static_cast<uint8_t>((literalLength >= 15 ? 15 : literalLength) << 4));
+    if (literalLength >= 15) WriteLength(out, literalLength - 15);
+    out.insert(out.end(), literals, literals + literalLength);
+}
+
+bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length) {
+    uint8_t b;
+    do {
+        if (ip >= end) return false;
+        b = *ip++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+} // namespace
+
+size_t LzCodec::Compress(const uint8_t* src, size_t n, std::vector<uint8_t>& out) {
+    size_t start = out.size();
+    out.reserve(start + MaxCompressedSize(n));
+
+    // An empty block is a single token with no literals; src may be null
+    if (n == 0) {
+        out.push_back(0);
+        return 1;
+    }
+
+    if (n < kMatchLimit + 1) {
+        EmitLastLiterals(out, src, n);
+        return out.size() - start;
+    }
+
+    std::vector<uint32_t> table(1u << kHashBits, 0);
+    const size_t matchLimit = n - kMatchLimit;
+    const size_t matchEnd = n - kLastLiterals;
+    size_t anchor = 0;
+    size_t ip = 1;
+
+    while (ip < matchLimit) {
+        uint32_t sequence = Read32(src + ip);
+        uint32_t h = Hash(sequence);
+        size_t candidate = table[h];
+        table[h] = static_cast<uint32_t>(ip);
+
+        if (candidate >= ip || ip - candidate > kMaxOffset || Read32(src + candidate) != sequence) {
+            ip++;
+            continue;
+        }
+
+        // Extend backwards over pending literals, then forwards.
+        while (ip > anchor && candidate > 0 && src[ip - 1] == src[candidate - 1]) {
+            ip--;
+            candidate--;
+        }
+        size_t length = kMinMatch;
+        while (ip + length < matchEnd && src[ip + length] == src[candidate + length]) {
+            length++;
+        }
+
+        EmitSequence(out, src + anchor, ip - anchor, ip - candidate, length);
+        ip += length;
+        anchor = ip;
+
+        if (ip < matchLimit) {
+            table[Hash(Read32(src + ip - 2))] = static_cast<uint32_t>(ip - 2);
+        }
+    }
+
+    EmitLastLiterals(out, src + anchor, n - anchor);
+    return out.size() - start;
+}
+
+bool LzCodec::Decompress(const uint8_t* src, size_t n, size_t rawSize, std::vector<uint8_t>& out) {
+    out.resize(rawSize);
+    // Nothing to copy, and src or out.data() may be null: only the lone
+    // empty token is valid
+    if (rawSize == 0) return n == 1 && src[0] == 0;
+    if (n == 0) return false;
+
+    const uint8_t* ip = src;
+    const uint8_t* end = src + n;
+    size_t op = 0;
+
+    while (ip < end) {
+        uint8_t token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !ReadLength(ip, end, literalLength)) return false;
+        if (literalLength > (size_t)(end - ip) || literalLength > rawSize - op) return false;
+        memcpy(out.data() + op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        if (ip == end) break; // last sequence carries literals only
+
+        if (end - ip < 2) return false;
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) return false;
+
+        size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !ReadLength(ip, end, matchLength)) return false;
+        matchLength += kMinMatch;
+        if (matchLength > rawSize - op) return false;
+
+        // Byte-wise copy: overlapping matches (offset < length) are valid.
+        uint8_t* dst = out.data() + op;
+        const uint8_t* ref = dst - offset;
+        for (size_t i = 0; i < matchLength; ++i) {
+            dst[i] = ref[i];
+        }
+        op += matchLength;
+    }
+
+    return op == rawSize;
+}
@@ -6,84 +6,120 @@
 #include "ns3/applications-module.h"
 #include "ns3/flow-monitor-module.h"
 #include "ns3/energy-module.h"
-#include "ns3/olsr-helper.h"
-#include "ns3/ipv4-list-routing-helper.h"
-#include "ns3/ipv4-static-routing-helper.h"
 #include "ns3/random-variable-stream.h"
 
 #include "event_emitter.h"
+#include "scenario.h"
+#include "simulation_evaluator.h"
+#include "fitness_cache.h"
+#include "energy_model_helper.h"
+#include "frame_emitter.h"
+#include "telemetry_sink.h"
+#include "event_log.h"
 #include "ascon_crypto.h"
 #include "snake_optimizer.h"
+#include "pareto_optimizer.h"
+#include "sensitivity_analysis.h"
+#include "surrogate_optimizer.h"
 #include "memostp_protocol.h"
 #include "crypto_app.h"
+#include "duty_cycle_scheduler.h"
+#include "tx_power_controller.h"
+#include "cluster_manager.h"
+#include "cluster_app.h"
 #include "node_monitor.h"
+#include "death_tracker.h"
+#include "online_optimizer.h"
+#include "coverage_engine.h"
+#include "connectivity_tracker.h"
 #include "metrics_collector.h"
+#include "rng_stream_manager.h"
+#include <sstream>
+#include <cstdlib>
+#include <cmath>
+#include <cctype>
+#include <limits>
 
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("MEMOSTPSimulation");
 
-class EnergyModelHelper {
-public:
-    static void InstallEnergyModel(NodeContainer& nodes, double initialEnergy) {
-        BasicEnergySourceHelper energySourceHelper;
-        energySourceHelper.Set("BasicEnergySourceInitialEnergyJ", DoubleValue(initialEnergy));
-        
-        EnergySourceContainer energySources = energySourceHelper.Install(nodes);
-        
-        // Simple energy consumption model
-        for (uint32_t i = 0; i < nodes.GetN(); ++i) {
-            Ptr<BasicEnergySource> source = DynamicCast<BasicEnergySource>(energySources.Get(i));
-            source->SetNode(nodes.Get(i));
-        }
-    }
-    
-    static double GetRemainingEnergy(NodeContainer& nodes, uint32_t nodeId) {
-        if (nodeId < nodes.GetN()) {
-            Ptr<EnergySource> source = nodes.Get(nodeId)->GetObject<EnergySource>();
-            if (source) {
-                return source->GetRemainingEnergy();
-            }
-        }
-        return 0.0;
+// Sensitivity of lifetime, delivery and energy to the optimizer's three
+// parameters and the resilience factor (the power controller's neighbour
+// redundancy), measured by the sub-simulation workers.
+static bool RunSensitivityAnalysis(SimulationFitnessEvaluator& simFitness, SensitivityAnalysis::Method method,
+                                   uint32_t samples, const std::string& cachePath, const std::string& outPath) {
+    if (!simFitness.IsRunning()) {
+        std::cerr << "Sensitivity analysis needs sub-simulation workers, none could be started" << std::endl;
+        return false;
     }
-};
-
-class DeathChecker : public Object {
-public:
-    DeathChecker(NodeContainer& nodes, NodeMonitor& monitor, double checkInterval = 1.0)
-        : m_nodes(nodes), m_monitor(monitor), m_checkInterval(checkInterval) {}
     
-    void Start() {
-        Simulator::Schedule(Seconds(m_checkInterval), &DeathChecker::CheckNodes, this);
+    // The resilience factor rounds to 1-3 neighbours; half-integer bounds
+    // give each count the same share of the samples
+    const std::vector<double>& lower = EnhancedSnakeOptimizer::getLowerBounds();
+    const std::vector<double>& upper = EnhancedSnakeOptimizer::getUpperBounds();
+    std::vector<SensitivityAnalysis::Parameter> parameters = {
+        {"energy_weight", lower[0], upper[0]},
+        {"power_control", lower[1], upper[1]},
+        {"sleep_ratio", lower[2], upper[2]},
+        {"resilience_factor", 0.5, 3.5}
+    };
+    
+    FitnessCache cache(&simFitness, simFitness.GetContextHash());
+    if (!cachePath.empty()) {
+        cache.Open(cachePath);
     }
-    
-private:
-    void CheckNodes() {
-        double currentTime = Simulator::Now().GetSeconds();
-        
-        for (uint32_t i = 0; i < m_nodes.GetN(); ++i) {
-            if (m_monitor.IsNodeAlive(i)) {
-                double remainingEnergy = EnergyModelHelper::GetRemainingEnergy(m_nodes, i);
-                if (remainingEnergy <= 0.05) { // Node dies when energy < 0.05J
-                    m_monitor.CheckNodeDeath(i, currentTime, "Energy Depletion");
-                    
-                    // Disable node applications
-                    Ptr<Node> node = m_nodes.Get(i);
-                    for (uint32_t appIdx = 0; appIdx < node->GetNApplications(); ++appIdx) {
-                        node->GetApplication(appIdx)->SetStopTime(Seconds(currentTime));
-                    }
-                }
+    SensitivityAnalysis analysis(parameters, {"lifetime_s", "pdr", "energy_per_bit_j"},
+        [&](const std::vector<std::vector<double>>& candidates, std::vector<std::vector<double>>& outputs) {
+            std::vector<std::vector<double>> objectives;
+            simFitness.EvaluateObjectives(candidates, objectives, &cache);
+            outputs.resize(candidates.size());
+            for (size_t i = 0; i < candidates.size(); i++) {
+                // Failed runs come back with maximal delay; a run in which
+                // no node spent energy projects an unbounded lifetime
+                const std::vector<double>& v = objectives[i];
+                bool failed = v.size() < 4 || v[2] == std::numeric_limits<double>::max() ||
+                              v[0] == std::numeric_limits<double>::max();
+                outputs[i] = failed ? std::vector<double>(3, std::nan(""))
+                                    : std::vector<double>{v[0], v[1], v[3]};
             }
+        });
+    
+    // Batches of a few runs per worker keep the pool busy and report progress
+    analysis.setBatchSize(4 * simFitness.GetWorkerCount());
+    analysis.setRandomStream(RngStreamManager::Instance().GetStream("sensitivity"));
+    bool ok = analysis.run(method, samples);
+    if (ok) {
+        analysis.printReport();
+        if (!outPath.empty()) {
+            analysis.exportCsv(outPath);
         }
-        
-        Simulator::Schedule(Seconds(m_checkInterval), &DeathChecker::CheckNodes, this);
     }
     
-    NodeContainer& m_nodes;
-    NodeMonitor& m_monitor;
-    double m_checkInterval;
-};
+    std::cout << "🧪 Sensitivity runs: " << simFitness.GetSimulationCount() << " sub-simulations" << std::endl;
+    cache.PrintReport();
+    cache.Close();
+    simFitness.Stop();
+    return ok;
+}
+
+// Share of all bytes sent by flows with a source or destination port in
+// [firstPort, lastPort]
+static double FlowByteShare(Ptr<FlowMonitor> monitor, Ptr<Ipv4FlowClassifier> classifier,
+                            uint16_t firstPort, uint16_t lastPort) {
+    if (!monitor || !classifier) return 0.0;
+    
+    uint64_t matched = 0;
+    uint64_t total = 0;
+    for (const auto& flow : monitor->GetFlowStats()) {
+        Ipv4FlowClassifier::FiveTuple tuple = classifier->FindFlow(flow.first);
+        bool inRange = (tuple.sourcePort >= firstPort && tuple.sourcePort <= lastPort) ||
+                       (tuple.destinationPort >= firstPort && tuple.destinationPort <= lastPort);
+        total += flow.second.txBytes;
+        matched += inRange ? flow.second.txBytes : 0;
+    }
+    return total > 0 ? (double)matched / total : 0.0;
+}
 
 int main(int argc, char *argv[]) {
     EventEmitter& emitter = EventEmitter::Instance();
@@ -96,10 +132,56 @@ int main(int argc, char *argv[]) {
     double area = 400.0;
     int optimization_iters = 6;
     bool enable_optimization = true;
+    uint32_t optPopulation = 30;
+    uint32_t optThreads = 0;
+    std::string optFitness = "model";
+    double optSimTime = 20.0;
+    uint32_t optWorkers = 0;
+    std::string optCache = "fitness_cache.bin";
+    std::string optCheckpoint = "";
+    uint32_t optCheckpointEvery = 1;
+    bool resumeOpt = false;
+    std::string optMode = "snake";
+    uint32_t surrogateEvals = 24;
+    uint32_t surrogateBatch = 0;
+    std::string paretoFront = "pareto_front.csv";
+    std::string optPick = "balanced";
+    std::string optParams = "";
+    uint32_t paramRegions = 1;
+    std::string sensitivity = "";
+    uint32_t saSamples = 16;
+    std::string saOut = "sensitivity.csv";
+    bool reoptimize = false;
+    double reoptThreshold = 0.7;
+    int reoptIters = 3;
+    uint32_t reoptBudget = 8;
     bool enable_crypto = true;
     bool enable_node_death = true;
-    double initialNodeEnergy = 5.0;
-    double deathCheckInterval = 2.0;
+    double initialNodeEnergy = 100.0;
+    bool wall_clock_stamps = false;
+    double frameTick = 1.0;
+    std::string telemetry = "stdout";
+    std::string telemetryName = "/wsn_telemetry";
+    std::string eventLogPath = "";
+    double sensingRadius = 20.0;
+    double coverageCell = 1.0;
+    uint32_t coverageK = 2;
+    double commRange = 0.0;
+    std::string radioProfile = "wifi";
+    double dutyPeriod = 0.0;
+    std::string wakeMode = "staggered";
+    bool enable_power_control = false;
+    double txPowerMin = 0.0;
+    double txPowerUpdate = 5.0;
+    uint32_t txRedundancy = 1;
+    std::string mode = "flat";
+    double clusterFraction = 0.1;
+    double clusterRound = 20.0;
+    double readingInterval = 2.0;
+    double aggWindow = 5.0;
+    std::string aggFunction = "mean";
+    uint32_t aggCap = 32;
+    uint32_t sinkNode = 0;
     
     CommandLine cmd;
     cmd.AddValue("nNodes", "Number of nodes", nNodes);
@@ -107,12 +189,230 @@ int main(int argc, char *argv[]) {
     cmd.AddValue("area", "Simulation area (m)", area);
     cmd.AddValue("optIters", "Optimization iterations", optimization_iters);
     cmd.AddValue("enableOpt", "Enable optimization", enable_optimization);
+    cmd.AddValue("optPop", "Snake optimizer population size", optPopulation);
+    cmd.AddValue("optThreads", "Optimizer fitness threads, 0 = all cores", optThreads);
+    cmd.AddValue("optFitness", "Optimizer fitness: model (analytic) or sim (sub-simulations)", optFitness);
+    cmd.AddValue("optSimTime", "Sub-simulation length for --optFitness=sim (s)", optSimTime);
+    cmd.AddValue("optWorkers", "Sub-simulation worker processes, 0 = all cores", optWorkers);
+    cmd.AddValue("optCache", "Persistent cache of sub-simulation fitness, empty = off", optCache);
+    cmd.AddValue("optCheckpoint", "Snake optimizer checkpoint file, empty = off", optCheckpoint);
+    cmd.AddValue("optCheckpointEvery", "Iterations between optimizer checkpoints", optCheckpointEvery);
+    cmd.AddValue("resumeOpt", "Continue the optimization saved in --optCheckpoint", resumeOpt);
+    cmd.AddValue("optMode", "Optimizer: snake (weighted score), pareto (NSGA-II front) or surrogate (Gaussian process); "
+                 "pareto and surrogate need --optFitness=sim", optMode);
+    cmd.AddValue("surrogateEvals", "Sub-simulations for --optMode=surrogate", surrogateEvals);
+    cmd.AddValue("surrogateBatch", "Candidates simulated per surrogate round, 0 = one per worker", surrogateBatch);
+    cmd.AddValue("paretoFront", "CSV file for the Pareto front", paretoFront);
+    cmd.AddValue("optPick", "Pareto operating point: balanced or an objective name", optPick);
+    cmd.AddValue("paramRegions", "Parameter sets by distance ring around the sink: 1 = global, nNodes = per node", paramRegions);
+    cmd.AddValue("sensitivity", "Sensitivity analysis instead of a run: sobol or morris (uses sub-simulations)", sensitivity);
+    cmd.AddValue("saSamples", "Sobol base points (N(k+2) runs) or Morris trajectories (r(k+1) runs)", saSamples);
+    cmd.AddValue("saOut", "CSV file for the sensitivity indices", saOut);
+    cmd.AddValue("reoptimize", "Re-optimize with the model fitness while running when the alive fraction drops (needs --enableDeath)", reoptimize);
+    cmd.AddValue("reoptThreshold", "Alive fraction that triggers the first re-optimization", reoptThreshold);
+    cmd.AddValue("reoptIters", "Iterations per re-optimization", reoptIters);
+    cmd.AddValue("reoptBudget", "Fitness evaluations per re-optimization tick (1 sim s)", reoptBudget);
+    cmd.AddValue("optParams", "Apply parameters ew,pc,sr directly (e.g. a Pareto front row), skipping optimization", optParams);
     cmd.AddValue("enableCrypto", "Enable ASCON cryptography", enable_crypto);
     cmd.AddValue("enableDeath", "Enable node death tracking", enable_node_death);
     cmd.AddValue("initialEnergy", "Initial energy per node (J)", initialNodeEnergy);
-    cmd.AddValue("deathCheck", "Death check interval (s)", deathCheckInterval);
+    cmd.AddValue("dutyPeriod", "Radio duty-cycle period (s), 0 = radios always on", dutyPeriod);
+    cmd.AddValue("wakeMode", "Duty-cycle wake windows: staggered or sync", wakeMode);
+    cmd.AddValue("mode", "Traffic mode: flat (crypto pairs + echo) or cluster (LEACH)", mode);
+    cmd.AddValue("clusterFraction", "Desired fraction of cluster heads per round (LEACH p)", clusterFraction);
+    cmd.AddValue("clusterRound", "Cluster-head rotation round length (s)", clusterRound);
+    cmd.AddValue("readingInterval", "Sensor reading interval in cluster mode (s)", readingInterval);
+    cmd.AddValue("aggWindow", "Cluster-head aggregation window (sim s)", aggWindow);
+    cmd.AddValue("aggFunction", "Aggregation function: min, max, mean, count or concat", aggFunction);
+    cmd.AddValue("aggCap", "Readings per frame for concat aggregation", aggCap);
+    cmd.AddValue("powerControl", "Per-node transmit power control", enable_power_control);
+    cmd.AddValue("txPowerMin", "Lowest transmit power for power control (dBm)", txPowerMin);
+    cmd.AddValue("txPowerUpdate", "Transmit power recompute interval (s)", txPowerUpdate);
+    cmd.AddValue("txRedundancy", "Nearest neighbours each node keeps in reach under power control", txRedundancy);
+    cmd.AddValue("radioProfile", "Radio current profile: " + RadioHardwareProfile::Names(), radioProfile);
+    cmd.AddValue("wallClock", "Add cached wall-clock timestamps to events (profiling)", wall_clock_stamps);
+    cmd.AddValue("frameTick", "Node state frame interval (s), 0 = per-event updates", frameTick);
+    cmd.AddValue("telemetry", "Event channel: stdout, shm or both", telemetry);
+    cmd.AddValue("telemetryName", "Shared-memory segment name for --telemetry=shm|both", telemetryName);
+    cmd.AddValue("eventLog", "Write a compressed, seekable event log to this path", eventLogPath);
+    cmd.AddValue("sensingRadius", "Node sensing radius for coverage (m)", sensingRadius);
+    cmd.AddValue("coverageCell", "Coverage raster cell size (m)", coverageCell);
+    cmd.AddValue("coverageK", "Nodes required for k-coverage", coverageK);
+    cmd.AddValue("commRange", "Radio range for connectivity (m), 0 = from the link budget", commRange);
+    cmd.AddValue("sinkNode", "Sink node for reachability", sinkNode);
     cmd.Parse(argc, argv);
     
+    RadioHardwareProfile radio;
+    if (!RadioHardwareProfile::Lookup(radioProfile, radio)) {
+        std::cerr << "Unknown radio profile '" << radioProfile << "' (choose from "
+                  << RadioHardwareProfile::Names() << ")" << std::endl;
+        return 1;
+    }
+    
+    if (mode != "flat" && mode != "cluster") {
+        std::cerr << "Unknown mode '" << mode << "' (choose flat or cluster)" << std::endl;
+        return 1;
+    }
+    bool clustered = (mode == "cluster");
+    
+    if (sinkNode >= nNodes) {
+        std::cerr << "--sinkNode must be below --nNodes (" << nNodes << ")" << std::endl;
+        return 1;
+    }
+    // Sub-simulations always run clustered, so the round matters in flat mode too
+    if (!(clusterRound > 0.0)) {
+        std::cerr << "--clusterRound must be positive" << std::endl;
+        return 1;
+    }
+    
+    DataAggregator::Function aggregation = DataAggregator::Function::Mean;
+    if (!DataAggregator::ParseFunction(aggFunction, aggregation)) {
+        std::cerr << "Unknown aggregation function '" << aggFunction << "'" << std::endl;
+        return 1;
+    }
+    
+    DutyCycleScheduler::WakeMode dutyWakeMode = DutyCycleScheduler::WakeMode::Staggered;
+    if (!DutyCycleScheduler::ParseWakeMode(wakeMode, dutyWakeMode)) {
+        std::cerr << "Unknown wake mode '" << wakeMode << "' (choose staggered or sync)" << std::endl;
+        return 1;
+    }
+    
+    if (optFitness != "model" && optFitness != "sim") {
+        std::cerr << "Unknown optimizer fitness '" << optFitness << "' (choose model or sim)" << std::endl;
+        return 1;
+    }
+    
+    if (optMode != "snake" && optMode != "pareto" && optMode != "surrogate") {
+        std::cerr << "Unknown optimizer mode '" << optMode << "' (choose snake, pareto or surrogate)" << std::endl;
+        return 1;
+    }
+    if (optMode != "snake" && optFitness != "sim") {
+        std::cerr << "--optMode=" << optMode << " is built for sub-simulation fitness; add --optFitness=sim" << std::endl;
+        return 1;
+    }
+    if (surrogateEvals == 0) {
+        std::cerr << "--surrogateEvals must be at least 1" << std::endl;
+        return 1;
+    }
+    
+    SensitivityAnalysis::Method saMethod = SensitivityAnalysis::Method::Sobol;
+    if (!sensitivity.empty() && !SensitivityAnalysis::parseMethod(sensitivity, saMethod)) {
+        std::cerr << "Unknown sensitivity method '" << sensitivity << "' (choose sobol or morris)" << std::endl;
+        return 1;
+    }
+    
+    if (resumeOpt && optCheckpoint.empty()) {
+        std::cerr << "--resumeOpt needs a checkpoint file (--optCheckpoint)" << std::endl;
+        return 1;
+    }
+    if (resumeOpt && optMode != "snake") {
+        std::cout << "⚠️  --resumeOpt applies to the snake optimizer; a " << optMode
+                  << " rerun replays from --optCache" << std::endl;
+    }
+    
+    paramRegions = std::max(1u, std::min(paramRegions, nNodes));
+    if (paramRegions > 1 && (optFitness == "sim" || optMode != "snake")) {
+        std::cerr << "--paramRegions > 1 is scored by the per-node analytic kernel; use --optFitness=model --optMode=snake" << std::endl;
+        return 1;
+    }
+    
+    std::vector<double> presetParams;
+    if (!optParams.empty()) {
+        const std::vector<double>& lower = EnhancedSnakeOptimizer::getLowerBounds();
+        const std::vector<double>& upper = EnhancedSnakeOptimizer::getUpperBounds();
+        std::stringstream list(optParams);
+        std::string field;
+        while (std::getline(list, field, ',')) {
+            char* end = nullptr;
+            double value = std::strtod(field.c_str(), &end);
+            while (end && std::isspace((unsigned char)*end)) end++;
+            if (field.empty() || end == field.c_str() || *end != '\0' || !std::isfinite(value)) {
+                std::cerr << "--optParams: '" << field << "' is not a number" << std::endl;
+                return 1;
+            }
+            size_t d = presetParams.size() % lower.size();
+            if (value < lower[d] || value > upper[d]) {
+                std::cerr << "--optParams: value " << presetParams.size() + 1 << " (" << value
+                          << ") is outside the optimizer's range " << lower[d] << "-" << upper[d] << std::endl;
+                return 1;
+            }
+            presetParams.push_back(value);
+        }
+        size_t triple = EnhancedSnakeOptimizer::getDefaultParams().size();
+        if (presetParams.size() != triple && presetParams.size() != triple * paramRegions) {
+            std::cerr << "--optParams takes " << triple << " comma-separated values (energy weight, power control, "
+                      << "sleep ratio), or " << triple << " per region" << std::endl;
+            return 1;
+        }
+    }
+    
+    Scenario scenario;
+    scenario.nNodes = nNodes;
+    scenario.area = area;
+    scenario.simulationTime = simulationTime;
+    scenario.sinkNode = sinkNode;
+    scenario.initialEnergy = initialNodeEnergy;
+    scenario.deathThreshold = NodeMonitor::kDeathThreshold;
+    scenario.radio = radio;
+    scenario.powerControl = enable_power_control;
+    scenario.txPowerMin = txPowerMin;
+    scenario.txPowerUpdate = txPowerUpdate;
+    scenario.txRedundancy = std::max(1u, txRedundancy);
+    scenario.dutyPeriod = dutyPeriod;
+    scenario.wakeMode = dutyWakeMode;
+    scenario.clusterFraction = clusterFraction;
+    scenario.clusterRound = clusterRound;
+    scenario.readingInterval = readingInterval;
+    scenario.aggWindow = aggWindow;
+    scenario.aggregation = aggregation;
+    scenario.aggCap = aggCap;
+    
+    // Every stream derives from these two; rerun with the same values to
+    // reproduce a run exactly
+    std::cout << "🎲 RNG: seed " << RngSeedManager::GetSeed() << ", run " << RngSeedManager::GetRun()
+              << std::endl;
+    
+    // Sub-simulation workers fork here, before telemetry, threads or any
+    // ns-3 objects exist in this process
+    SimulationFitnessEvaluator simFitness(scenario, std::min(optSimTime, simulationTime));
+    if ((enable_optimization && optFitness == "sim" && presetParams.empty()) || !sensitivity.empty()) {
+        if (simFitness.Start(optWorkers)) {
+            std::cout << "🧪 Optimizer fitness: " << simFitness.GetWorkerCount() << " worker(s), "
+                      << std::min(optSimTime, simulationTime) << "s sub-simulations" << std::endl;
+        } else {
+            std::cout << "⚠️  Optimizer fitness: sub-simulations unavailable, using the analytic model" << std::endl;
+        }
+    }
+    
+    // Sensitivity analysis replaces the run; it only needs the workers
+    if (!sensitivity.empty()) {
+        if (!enable_power_control) {
+            std::cout << "⚠️  The resilience factor only acts under power control; add --powerControl=true "
+                      << "to measure it" << std::endl;
+        }
+        return RunSensitivityAnalysis(simFitness, saMethod, saSamples, optCache, saOut) ? 0 : 1;
+    }
+    
+    if (wall_clock_stamps) {
+        emitter.SetTimestampMode(EventEmitter::TimestampMode::SimTimeWithWallClock);
+    }
+    
+    TelemetrySink telemetrySink;
+    if (telemetry == "shm" || telemetry == "both") {
+        if (telemetrySink.Open(telemetryName, nNodes)) {
+            emitter.AttachTelemetrySink(&telemetrySink, telemetry == "both");
+            std::cout << "📡 Telemetry: shared memory " << telemetryName << std::endl;
+        } else {
+            std::cout << "⚠️  Telemetry: shared memory unavailable, using stdout JSON" << std::endl;
+        }
+    }
+    
+    EventLogWriter eventLog;
+    if (!eventLogPath.empty() && eventLog.Open(eventLogPath)) {
+        emitter.AttachEventLog(&eventLog);
+        std::cout << "🗜️  Event log: " << eventLogPath << " (+ .idx)" << std::endl;
+    }
+    
     emitter.EmitEvent("config", 0, nNodes, static_cast<int>(simulationTime));
     
     std::cout << "\033[1;36m╔══════════════════════════════════════════════════════════════╗\033[0m" << std::endl;
@@ -124,93 +424,174 @@ int main(int argc, char *argv[]) {
     nodes.Create(nNodes);
     
     // Initialize node monitor
+    FrameEmitter& frameEmitter = FrameEmitter::Instance();
+    frameEmitter.Configure(nNodes, frameTick);
+    
     NodeMonitor nodeMonitor;
     nodeMonitor.InitializeNodes(nNodes, initialNodeEnergy);
     
-    // Install energy model if death tracking is enabled
-    if (enable_node_death) {
-        EnergyModelHelper::InstallEnergyModel(nodes, initialNodeEnergy);
-        std::cout << "🔋 Initial Node Energy: " << initialNodeEnergy << " J" << std::endl;
-    }
-    
     // Setup mobility (grid layout)
-    MobilityHelper mobility;
-    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
-    
-    double gridSpacing = 15.0;
-    uint32_t gridSize = ceil(std::sqrt(nNodes));
-    
-    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
-                                 "MinX", DoubleValue(20.0),
-                                 "MinY", DoubleValue(20.0),
-                                 "DeltaX", DoubleValue(gridSpacing),
-                                 "DeltaY", DoubleValue(gridSpacing),
-                                 "GridWidth", UintegerValue(gridSize),
-                                 "LayoutType", StringValue("RowFirst"));
-    mobility.Install(nodes);
-    
-    // Update node positions in monitor
+    scenario.InstallMobility(nodes);
+    
+    // Update node positions in monitor and stamp their sensing disks
+    CoverageEngine coverage;
+    coverage.Configure(area, sensingRadius, coverageCell, coverageK);
+    
     for (uint32_t i = 0; i < nNodes; ++i) {
         Ptr<MobilityModel> mobilityModel = nodes.Get(i)->GetObject<MobilityModel>();
         if (mobilityModel) {
             Vector position = mobilityModel->GetPosition();
             nodeMonitor.UpdatePosition(i, position.x, position.y);
+            coverage.AddNode(i, position.x, position.y);
         }
     }
+    nodeMonitor.AttachCoverageEngine(&coverage);
+    
+    std::cout << "📐 Network Layout: " << scenario.GetGridSize() << "×" << scenario.GetGridSize() 
+              << " grid, spacing: " << scenario.gridSpacing << "m" << std::endl;
+    std::cout << "📡 Sensing Coverage: " << std::fixed << std::setprecision(1)
+              << coverage.GetCoverage() << "% of " << area << "×" << area << "m (r="
+              << sensingRadius << "m, " << coverageK << "-coverage "
+              << coverage.GetKCoverage() << "%)" << std::endl;
+    
+    // Unit-disk radio graph from the link budget unless overridden
+    if (commRange <= 0.0) {
+        commRange = scenario.GetLinkBudgetRange();
+    }
+    
+    ConnectivityTracker connectivity;
+    connectivity.Configure(area, commRange, sinkNode);
+    for (uint32_t i = 0; i < nNodes; ++i) {
+        NodeMonitor::NodeStatus status = nodeMonitor.GetNodeStatus(i);
+        connectivity.AddNode(i, status.positionX, status.positionY);
+    }
+    connectivity.Build();
+    nodeMonitor.AttachConnectivityTracker(&connectivity);
     
-    std::cout << "📐 Network Layout: " << gridSize << "×" << gridSize 
-              << " grid, spacing: " << gridSpacing << "m" << std::endl;
+    std::cout << "🔗 Radio Graph: range " << std::fixed << std::setprecision(1) << commRange
+              << "m, " << connectivity.GetComponentCount() << " component(s), "
+              << connectivity.GetSinkReachableCount() << "/" << nNodes
+              << " nodes reach sink " << sinkNode << std::endl;
     
     // Setup WiFi
-    YansWifiChannelHelper channel;
-    channel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
-    channel.AddPropagationLoss("ns3::LogDistancePropagationLossModel",
-        "Exponent", DoubleValue(3.0),
-        "ReferenceDistance", DoubleValue(1.0),
-        "ReferenceLoss", DoubleValue(46.677));
-    
-    YansWifiPhyHelper phy;
-    phy.SetChannel(channel.Create());
-    phy.Set("TxPowerStart", DoubleValue(20.0));
-    phy.Set("TxPowerEnd", DoubleValue(20.0));
-    
-    WifiHelper wifi;
-    wifi.SetStandard(WIFI_STANDARD_80211b);
-    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
-                                 "DataMode", StringValue("DsssRate2Mbps"),
-                                 "ControlMode", StringValue("DsssRate1Mbps"));
-    
-    WifiMacHelper mac;
-    mac.SetType("ns3::AdhocWifiMac");
-    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
-    
-    // Internet stack
-    OlsrHelper olsr;
-    olsr.Set("HelloInterval", TimeValue(Seconds(2.0)));
-    
-    Ipv4StaticRoutingHelper staticRouting;
-    Ipv4ListRoutingHelper list;
-    list.Add(staticRouting, 0);
-    list.Add(olsr, 10);
-    
-    InternetStackHelper internet;
-    internet.SetRoutingHelper(list);
-    internet.Install(nodes);
-    
-    Ipv4AddressHelper ipv4;
-    ipv4.SetBase("10.1.1.0", "255.255.255.0");
-    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+    NetDeviceContainer devices = scenario.InstallRadios(nodes);
+    
+    // Install energy model if death tracking is enabled; the radio model
+    // drains the source from actual PHY activity
+    EnergyModelHelper energyModel(radio);
+    if (enable_node_death) {
+        energyModel.InstallEnergyModel(nodes, devices, initialNodeEnergy, NodeMonitor::kDeathThreshold);
+        std::cout << "🔋 Initial Node Energy: " << initialNodeEnergy << " J ("
+                  << radio.name << " radio profile)" << std::endl;
+    }
+    
+    // Internet stack (OLSR)
+    Ipv4InterfaceContainer interfaces = scenario.InstallInternet(nodes, devices);
     
     // MEMOSTP protocol
     EnhancedMEMOSTPProtocol memostp(nodes, optimization_iters);
     memostp.setCryptoEnabled(enable_crypto);
+    memostp.configureOptimizer(optPopulation, optThreads);
+    memostp.configureRegions(paramRegions, nodeMonitor.PositionXColumn(), nodeMonitor.PositionYColumn(), sinkNode);
+    bool perNodeParams = memostp.getRegionCount() > 1;
+    const ParameterMatrix& nodeParams = memostp.getNodeParameters();
+    FitnessCache fitnessCache(&simFitness, simFitness.GetContextHash());
+    if (simFitness.IsRunning()) {
+        if (!optCache.empty()) {
+            fitnessCache.Open(optCache);
+        }
+        memostp.setFitnessEvaluator(&fitnessCache);
+    }
+    
+    // A checkpoint resumes only into the same deployment, fitness and layout
+    if (!optCheckpoint.empty()) {
+        uint64_t checkpointContext = simFitness.IsRunning() ? simFitness.GetContextHash() : scenario.Hash();
+        checkpointContext = FitnessCache::Hash(&paramRegions, sizeof(paramRegions), checkpointContext);
+        memostp.configureCheckpoint(optCheckpoint, checkpointContext, optCheckpointEvery, resumeOpt);
+    }
+    
+    if (!presetParams.empty()) {
+        memostp.setParameters(presetParams);
+    } else if (enable_optimization && optMode == "pareto" && simFitness.IsRunning()) {
+        std::cout << "\n\033[1;33m🚀 Starting Pareto Optimization...\033[0m" << std::endl;
+        ParetoOptimizer pareto(
+            {{"lifetime_s", true}, {"pdr", true}, {"delay_s", false}, {"energy_per_bit_j", false}},
+            [&](const std::vector<std::vector<double>>& candidates, std::vector<std::vector<double>>& objectives) {
+                simFitness.EvaluateObjectives(candidates, objectives, &fitnessCache);
+            });
+        pareto.setPopulationSize(optPopulation);
+        pareto.setRandomStream(RngStreamManager::Instance().GetStream("pareto_optimizer"));
+        pareto.optimize(optimization_iters);
+        pareto.printFront();
+        if (!paretoFront.empty()) {
+            pareto.exportFront(paretoFront);
+        }
+        
+        ParetoOptimizer::Solution point;
+        if (!pareto.pick(optPick, point)) {
+            std::cerr << "Unknown --optPick '" << optPick << "' (choose " << pareto.criteria()
+                      << "), using balanced" << std::endl;
+            pareto.pick("balanced", point);
+        }
+        memostp.setParameters(point.params);
+    } else if (enable_optimization && optMode == "surrogate" && simFitness.IsRunning()) {
+        std::cout << "\n\033[1;33m🚀 Starting Surrogate Optimization...\033[0m" << std::endl;
+        SurrogateOptimizer surrogate(&fitnessCache);
+        surrogate.setBudget(surrogateEvals);
+        surrogate.setBatchSize(surrogateBatch > 0 ? surrogateBatch : simFitness.GetWorkerCount());
+        surrogate.setThreadCount(optThreads);
+        surrogate.setRandomStream(RngStreamManager::Instance().GetStream("surrogate_optimizer"));
+        memostp.setParameters(surrogate.optimize());
+    }
     
-    if (enable_optimization) {
+    if (enable_optimization || !presetParams.empty()) {
         memostp.initializeProtocol();
     }
+    // Online re-optimization scores with the model fitness: a batch of
+    // sub-simulations would block the event loop on the worker pipes, and
+    // the workers only know the full-energy scenario
+    if (simFitness.IsRunning()) {
+        std::cout << "🧪 Optimizer fitness: " << simFitness.GetSimulationCount()
+                  << " sub-simulations" << std::endl;
+        fitnessCache.PrintReport();
+        fitnessCache.Close();
+        simFitness.Stop();
+        memostp.setFitnessEvaluator(nullptr);
+        if (reoptimize) {
+            std::cout << "🔁 Online re-optimization uses the model fitness" << std::endl;
+        }
+    }
+    
+    // Transmit power from the optimized power-control parameter and the link
+    // losses learned at full power during the first seconds
+    TxPowerController txPower;
+    if (enable_power_control) {
+        txPower.Configure(devices, txPowerMin, scenario.txPowerDbm, scenario.rxSensitivityDbm,
+                          memostp.getPowerControl(), scenario.txRedundancy);
+        if (perNodeParams) {
+            txPower.SetPowerControl(nodeParams.CopyColumn(ParameterMatrix::PowerControl));
+        }
+        txPower.Start(5.0, txPowerUpdate);
+        std::cout << "📶 Power control: target margin " << std::fixed << std::setprecision(1)
+                  << txPower.GetTargetMargin() << " dB, " << txPowerMin << "-" << scenario.txPowerDbm
+                  << " dBm" << std::endl;
+    }
+    
+    // Duty cycling from the optimized sleep ratio
+    DutyCycleScheduler dutyCycle;
+    if (dutyPeriod > 0.0) {
+        dutyCycle.Configure(devices, dutyPeriod, memostp.getSleepRatio(), dutyWakeMode);
+        if (perNodeParams) {
+            dutyCycle.SetSleepRatio(nodeParams.CopyColumn(ParameterMatrix::SleepRatio));
+        }
+        dutyCycle.Start(1.0);
+        std::cout << "😴 Duty cycling: period " << dutyPeriod << "s, sleep ratio "
+                  << std::fixed << std::setprecision(2) << memostp.getSleepRatio()
+                  << " (" << wakeMode << ")" << std::endl;
+    }
     
     // Setup crypto applications
-    if (enable_crypto) {
+    if (enable_crypto && !clustered) {
         uint16_t cryptoPort = 9999;
         uint32_t cryptoPairs = std::min<uint32_t>(8, nodes.GetN() / 2);
         
@@ -232,6 +613,9 @@ int main(int argc, char *argv[]) {
             Ptr<CryptoTestApplication> sendApp = CreateObject<CryptoTestApplication>();
             sendApp->Setup(sendSocket, InetSocketAddress(interfaces.GetAddress(receiverIdx), cryptoPort), 
                           cryptoPort, 512, &memostp, false, senderIdx);
+            if (dutyCycle.IsEnabled()) {
+                sendApp->SetDutyCycle(&dutyCycle);
+            }
             nodes.Get(senderIdx)->AddApplication(sendApp);
             sendApp->SetStartTime(Seconds(3.0 + i * 0.5));
             sendApp->SetStopTime(Seconds(simulationTime - 3.0));
@@ -240,37 +624,85 @@ int main(int argc, char *argv[]) {
         std::cout << "📡 Setup " << cryptoPairs << " crypto pairs" << std::endl;
     }
     
-    // Add echo traffic for testing
+    // Echo test traffic in flat mode, one port per server
     uint16_t echoPort = 9;
     uint32_t numServers = std::max(1u, nNodes / 5);
-    
-    for (uint32_t i = 0; i < numServers; i++) {
-        UdpEchoServerHelper echoServer(echoPort + i);
-        ApplicationContainer serverApps = echoServer.Install(nodes.Get(i));
-        serverApps.Start(Seconds(1.0));
-        serverApps.Stop(Seconds(simulationTime - 1.0));
+    if (!clustered) {
+        for (uint32_t i = 0; i < numServers; i++) {
+            UdpEchoServerHelper echoServer(echoPort + i);
+            ApplicationContainer serverApps = echoServer.Install(nodes.Get(i));
+            serverApps.Start(Seconds(1.0));
+            serverApps.Stop(Seconds(simulationTime - 1.0));
+        }
+        
+        for (uint32_t i = numServers; i < std::min<uint32_t>(nNodes, numServers * 4); i++) {
+            uint32_t serverIndex = i % numServers;
+            UdpEchoClientHelper echoClient(interfaces.GetAddress(serverIndex), echoPort + serverIndex);
+            
+            echoClient.SetAttribute("MaxPackets", UintegerValue(100));
+            echoClient.SetAttribute("Interval", TimeValue(Seconds(0.8)));
+            echoClient.SetAttribute("PacketSize", UintegerValue(512));
+            
+            ApplicationContainer clientApps = echoClient.Install(nodes.Get(i));
+            double startTime = 2.0 + (i - numServers) * 0.3;
+            clientApps.Start(Seconds(startTime));
+            clientApps.Stop(Seconds(simulationTime - 2.0));
+        }
     }
     
-    for (uint32_t i = numServers; i < std::min<uint32_t>(nNodes, numServers * 4); i++) {
-        uint32_t serverIndex = i % numServers;
-        UdpEchoClientHelper echoClient(interfaces.GetAddress(serverIndex), echoPort + serverIndex);
+    // Clustered sensing: LEACH rotation weighted by the optimized energy weight
+    ClusterManager clusters;
+    if (clustered) {
+        clusters.Configure(nodeMonitor, sinkNode, clusterFraction, memostp.getEnergyWeight(), clusterRound);
+        if (perNodeParams) {
+            clusters.SetEnergyWeight(nodeParams.CopyColumn(ParameterMatrix::EnergyWeight));
+        }
+        clusters.Start(2.0);
         
-        echoClient.SetAttribute("MaxPackets", UintegerValue(100));
-        echoClient.SetAttribute("Interval", TimeValue(Seconds(0.8)));
-        echoClient.SetAttribute("PacketSize", UintegerValue(512));
+        std::vector<Ipv4Address> addresses;
+        for (uint32_t i = 0; i < nNodes; ++i) {
+            addresses.push_back(interfaces.GetAddress(i));
+        }
         
-        ApplicationContainer clientApps = echoClient.Install(nodes.Get(i));
-        double startTime = 2.0 + (i - numServers) * 0.3;
-        clientApps.Start(Seconds(startTime));
-        clientApps.Stop(Seconds(simulationTime - 2.0));
+        uint16_t clusterPort = 9998;
+        for (uint32_t i = 0; i < nNodes; ++i) {
+            Ptr<ClusterTrafficApplication> app = CreateObject<ClusterTrafficApplication>();
+            app->Setup(&clusters, &memostp, i, addresses, clusterPort, readingInterval,
+                       aggWindow, aggregation, aggCap);
+            if (dutyCycle.IsEnabled()) {
+                app->SetDutyCycle(&dutyCycle);
+            }
+            nodes.Get(i)->AddApplication(app);
+            app->SetStartTime(Seconds(2.0));
+            app->SetStopTime(Seconds(simulationTime - 1.0));
+        }
+        
+        std::cout << "🛰️  Cluster mode: p=" << clusterFraction << ", round " << clusterRound
+                  << "s, sink node " << sinkNode << ", " << aggFunction << " aggregation every "
+                  << aggWindow << "s" << std::endl;
     }
     
-    // Start death checker if enabled
+    // Track node deaths from depletion notifications; the tracker must outlive Run()
+    Ptr<DeathTracker> deathTracker;
     if (enable_node_death) {
-        DeathChecker deathChecker(nodes, nodeMonitor, deathCheckInterval);
-        deathChecker.Start();
-        std::cout << "🔍 Node death tracking enabled (check every " 
-                  << deathCheckInterval << "s)" << std::endl;
+        deathTracker = CreateObject<DeathTracker>(nodes, nodeMonitor, energyModel);
+        deathTracker->Start();
+        if (enable_power_control) {
+            deathTracker->SetDeathCallback(MakeCallback(&TxPowerController::NodeDied, &txPower));
+        }
+        std::cout << "🔍 Node death tracking enabled (event-driven)" << std::endl;
+    }
+    
+    // Re-optimization on network degradation, spread over 1 s ticks
+    OnlineOptimizer onlineOptimizer;
+    if (reoptimize) {
+        onlineOptimizer.Configure(memostp, nodeMonitor, reoptThreshold, 0.1, reoptIters, reoptBudget);
+        onlineOptimizer.Attach(enable_power_control ? &txPower : nullptr, &dutyCycle,
+                               clustered ? &clusters : nullptr);
+        onlineOptimizer.Start(1.0, 1.0);
+        std::cout << "🔁 Online re-optimization below " << std::fixed << std::setprecision(0)
+                  << reoptThreshold * 100.0 << "% alive, " << reoptBudget
+                  << " evaluations per tick" << std::endl;
     }
     
     // Flow monitor
@@ -283,6 +715,8 @@ int main(int argc, char *argv[]) {
     std::cout << "\n\033[1;33m⏳ SIMULATION STARTED...\033[0m" << std::endl;
     emitter.EmitEvent("simulation_running", 0);
     
+    frameEmitter.Start();
+    
     Simulator::Stop(Seconds(simulationTime));
     Simulator::Run();
     
@@ -297,12 +731,22 @@ int main(int argc, char *argv[]) {
             double consumed = initialNodeEnergy - remaining;
             totalEnergy += consumed;
             
-            // Update node monitor
-            nodeMonitor.UpdateEnergy(i, consumed);
+            // The tracker keeps the monitor current; this picks up the tail
+            // since each node's last energy update
+            nodeMonitor.SetRemainingEnergy(i, remaining);
         }
     }
     
+    frameEmitter.Flush();
+    if (enable_node_death) {
+        energyModel.Finalize();
+    }
     metricsCollector.UpdateEnergyMetrics(totalEnergy, nNodes);
+    if (dutyCycle.IsEnabled()) {
+        metricsCollector.UpdateDutyCycleMetrics(
+            enable_node_death ? dutyCycle.GetEnergySaved(energyModel) : 0.0,
+            dutyCycle.GetAverageAddedLatency());
+    }
     
     // Update crypto metrics
     if (enable_crypto) {
@@ -312,6 +756,26 @@ int main(int argc, char *argv[]) {
         );
     }
     
+    // Readings that reached their destination: one per decrypted
+    // CryptoTestApplication packet in flat mode, per aggregated reading at
+    // the sink in cluster mode. Both modes charge them the network's energy
+    // less the share spent on other traffic: flat mode's echo flows, by
+    // their share of the bytes sent, so the two figures compare directly.
+    uint64_t readingsDelivered = clustered ? clusters.GetReadingsDelivered()
+                                           : memostp.getPacketsDecrypted();
+    double echoShare = clustered ? 0.0
+        : FlowByteShare(monitor, DynamicCast<Ipv4FlowClassifier>(flowmon.GetClassifier()),
+                        echoPort, echoPort + numServers - 1);
+    metricsCollector.UpdateReadingMetrics(readingsDelivered, totalEnergy * (1.0 - echoShare),
+                                          memostp.getPacketsEncrypted() + memostp.getPacketsDecrypted());
+    
+    metricsCollector.UpdateCoverageMetrics(nodeMonitor.GetNetworkCoverage(),
+                                           nodeMonitor.GetKCoverage(), coverageK);
+    metricsCollector.UpdateConnectivityMetrics(connectivity.GetSinkReachableRatio(),
+                                               connectivity.GetLargestComponentRatio(),
+                                               connectivity.GetComponentCount(),
+                                               connectivity.GetPartitionTime());
+    
     // Update death metrics
     double firstDeath = emitter.GetFirstNodeDeathTime();
     double lastDeath = emitter.GetLastNodeDeathTime();
@@ -332,12 +796,29 @@ int main(int argc, char *argv[]) {
     
     memostp.printProtocolStats();
     
+    if (enable_node_death) {
+        energyModel.PrintEnergyBreakdown();
+    }
+    dutyCycle.PrintReport(enable_node_death ? &energyModel : nullptr);
+    if (enable_power_control) {
+        txPower.PrintReport();
+    }
+    if (clustered) {
+        clusters.PrintReport();
+    }
+    if (reoptimize) {
+        onlineOptimizer.PrintReport();
+    }
+    
     // Get comprehensive metrics
     metricsCollector.PrintComprehensiveMetrics();
     
     // Export metrics to CSV
     metricsCollector.ExportMetricsToCSV("simulation_metrics.csv");
     nodeMonitor.ExportNodeData("node_status.csv");
+    if (enable_node_death) {
+        energyModel.ExportEnergyBreakdown("radio_energy.csv");
+    }
     
     // Display death statistics
     if (firstDeath > 0) {
@@ -357,6 +838,16 @@ int main(int argc, char *argv[]) {
     std::cout << "\n\033[1;32m✅ Simulation completed successfully!\033[0m" << std::endl;
     std::cout << "\033[1;37m" << std::string(70, '=') << "\033[0m" << std::endl;
     
+    emitter.AttachTelemetrySink(nullptr, true);
+    telemetrySink.Close();
+    
+    if (eventLog.IsOpen()) {
+        emitter.AttachEventLog(nullptr);
+        eventLog.Close();
+        std::cout << "🗜️  Event log: " << eventLog.GetRawBytes() << " bytes -> "
+                  << eventLog.GetCompressedBytes() << " bytes" << std::endl;
+    }
+    
     Simulator::Destroy();
     return 0;
 }
\ No newline at end of file
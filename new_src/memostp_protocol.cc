@@ -1,10 +1,14 @@
 #include "memostp_protocol.h"
 #include "event_emitter.h"
+#include "rng_stream_manager.h"
 #include <iostream>
 #include <iomanip>
+#include <cstring>
 
 EnhancedMEMOSTPProtocol::EnhancedMEMOSTPProtocol(ns3::NodeContainer &nodeContainer, int opt_iters)
     : nodes(nodeContainer), 
+      parametersPreset(false),
+      resumeOptimization(false),
       optimization_iterations(opt_iters),
       cryptoEnabled(true), 
       packetsEncrypted(0), 
@@ -15,13 +19,60 @@ EnhancedMEMOSTPProtocol::EnhancedMEMOSTPProtocol(ns3::NodeContainer &nodeContain
 }
 
 void EnhancedMEMOSTPProtocol::generateCryptoKeys() {
-    std::mt19937 rng(std::random_device{}());
-    std::uniform_int_distribution<uint8_t> dist(0, 255);
+    // Reproducible per --RngSeed/--RngRun like every other draw: this is a
+    // simulation key, not a secret
+    RngStream rng = RngStreamManager::Instance().GetStream("crypto_keys");
+    uint64_t words[4] = {rng(), rng(), rng(), rng()};
+    memcpy(cryptoKey, &words[0], sizeof(cryptoKey));
+    memcpy(cryptoNonce, &words[2], sizeof(cryptoNonce));
+}
+
+void EnhancedMEMOSTPProtocol::configureOptimizer(uint32_t populationSize, uint32_t threads) {
+    optimizer.setPopulationSize(populationSize);
+    optimizer.setThreadCount(threads);
     
-    for (int i = 0; i < 16; i++) {
-        cryptoKey[i] = dist(rng);
-        cryptoNonce[i] = dist(rng);
-    }
+    // Same --RngSeed/--RngRun, same candidates: reruns revisit the points
+    // the fitness cache already holds
+    optimizer.setRandomStream(RngStreamManager::Instance().GetStream("snake_optimizer"));
+}
+
+void EnhancedMEMOSTPProtocol::configureCheckpoint(const std::string& path, uint64_t context,
+                                                  uint32_t every, bool resume) {
+    optimizer.setCheckpoint(path, context, every);
+    resumeOptimization = resume;
+}
+
+void EnhancedMEMOSTPProtocol::configureRegions(uint32_t regions, ColumnView<double> x,
+                                               ColumnView<double> y, uint32_t sinkNode) {
+    nodeParams.AssignRegions(x, y, sinkNode, regions);
+    optimizer.setParameterLayout(nodeParams.GetRegionCount() > 1 ? &nodeParams : nullptr);
+}
+
+void EnhancedMEMOSTPProtocol::applyParameters(const std::vector<double>& params) {
+    optimizedParams = params;
+    nodeParams.Expand(params);
+}
+
+void EnhancedMEMOSTPProtocol::setParameters(const std::vector<double>& params) {
+    applyParameters(params);
+    parametersPreset = true;
+    optimizer.setStartingPoint(params);
+}
+
+void EnhancedMEMOSTPProtocol::setNetworkState(ColumnView<uint8_t> alive, ColumnView<double> remaining,
+                                              ColumnView<double> initial) {
+    nodeParams.SetNodeState(alive, remaining, initial);
+    optimizer.setNetworkDrain(nodeParams.GetMeanDrain());
+}
+
+void EnhancedMEMOSTPProtocol::beginReoptimization(int iterations) {
+    optimizer.start(iterations, true);
+}
+
+bool EnhancedMEMOSTPProtocol::continueReoptimization(uint32_t budget) {
+    if (!optimizer.step(budget)) return false;
+    applyParameters(optimizer.getBestParams());
+    return true;
 }
 
 void EnhancedMEMOSTPProtocol::initializeProtocol() {
@@ -37,14 +88,25 @@ void EnhancedMEMOSTPProtocol::initializeProtocol() {
         cryptoEngine.PrintCryptoMetrics();
     }
     
-    std::cout << "\n\033[1;33m🚀 Starting Parameter Optimization...\033[0m" << std::endl;
-    optimizedParams = optimizer.optimize(optimization_iterations);
+    if (!parametersPreset) {
+        std::cout << "\n\033[1;33m🚀 Starting Parameter Optimization...\033[0m" << std::endl;
+        applyParameters(optimizer.optimize(optimization_iterations, resumeOptimization));
+    }
     
     std::cout << "\n\033[1;32m✨ MEMOSTP PROTOCOL CONFIGURED:\033[0m" << std::endl;
     std::cout << "├─ Cryptography: " << (cryptoEnabled ? "ASCON-128" : "Disabled") << std::endl;
-    std::cout << "├─ Optimization: " << optimization_iterations << " iterations" << std::endl;
+    if (parametersPreset) {
+        std::cout << "├─ Parameters: preset operating point" << std::endl;
+    } else {
+        std::cout << "├─ Optimization: " << optimization_iterations << " iterations x "
+                  << optimizer.getPopulationSize() << " snakes" << std::endl;
+    }
     std::cout << "├─ Nodes: " << nodes.GetN() << std::endl;
-    std::cout << "└─ Parameters optimized successfully" << std::endl;
+    if (nodeParams.GetRegionCount() > 1) {
+        std::cout << "├─ Parameter Regions: " << nodeParams.GetRegionCount() << " rings around the sink ("
+                  << optimizer.getDimensions() << " parameters)" << std::endl;
+    }
+    std::cout << "└─ Parameters " << (parametersPreset ? "applied" : "optimized") << " successfully" << std::endl;
 }
 
 std::vector<uint8_t> EnhancedMEMOSTPProtocol::encryptPacket(const std::vector<uint8_t>& plaintext, 
@@ -98,14 +160,17 @@ std::vector<uint8_t> EnhancedMEMOSTPProtocol::decryptPacket(const std::vector<ui
 }
 
 double EnhancedMEMOSTPProtocol::getEnergyWeight() const { 
+    if (nodeParams.GetRegionCount() > 1) return nodeParams.GetMean(ParameterMatrix::EnergyWeight);
     return optimizedParams.size() > 0 ? optimizer.getBestEnergyWeight(optimizedParams) : 0.6; 
 }
 
 double EnhancedMEMOSTPProtocol::getPowerControl() const { 
+    if (nodeParams.GetRegionCount() > 1) return nodeParams.GetMean(ParameterMatrix::PowerControl);
     return optimizedParams.size() > 1 ? optimizer.getBestPowerControl(optimizedParams) : 0.7; 
 }
 
 double EnhancedMEMOSTPProtocol::getSleepRatio() const { 
+    if (nodeParams.GetRegionCount() > 1) return nodeParams.GetMean(ParameterMatrix::SleepRatio);
     return optimizedParams.size() > 2 ? optimizer.getBestSleepRatio(optimizedParams) : 0.3; 
 }
 
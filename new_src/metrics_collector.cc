@@ -8,9 +8,11 @@
 #include <numeric>
 #include <cmath>
 
-MetricsCollector::MetricsCollector() {
+MetricsCollector::MetricsCollector() : coverageMeasured(false), connectivityMeasured(false),
+                                       dutyCycled(false) {
     // Initialize all metrics to zero
     metrics = NetworkMetrics{};
+    metrics.partitionTime = -1.0;
 }
 
 void MetricsCollector::CollectFlowMetrics(ns3::Ptr<ns3::FlowMonitor> monitor) {
@@ -21,6 +23,7 @@ void MetricsCollector::CollectFlowMetrics(ns3::Ptr<ns3::FlowMonitor> monitor) {
     metrics.totalTxPackets = 0;
     metrics.totalRxPackets = 0;
     metrics.totalLostPackets = 0;
+    metrics.totalRxBytes = 0;
     
     double totalDelay = 0.0;
     double totalThroughput = 0.0;
@@ -31,6 +34,7 @@ void MetricsCollector::CollectFlowMetrics(ns3::Ptr<ns3::FlowMonitor> monitor) {
         metrics.totalTxPackets += flow.second.txPackets;
         metrics.totalRxPackets += flow.second.rxPackets;
         metrics.totalLostPackets += flow.second.lostPackets;
+        metrics.totalRxBytes += flow.second.rxBytes;
         
         if (flow.second.rxPackets > 0) {
             double flowDuration = (flow.second.timeLastRxPacket - flow.second.timeFirstTxPacket).GetSeconds();
@@ -70,6 +74,23 @@ void MetricsCollector::UpdateEnergyMetrics(double energyConsumed, uint32_t nodeC
     metrics.energyPerNode = (nodeCount > 0) ? energyConsumed / nodeCount : 0.0;
     metrics.energyEfficiency = (energyConsumed > 0) ? 
         metrics.totalRxPackets / energyConsumed : 0.0;
+    metrics.energyPerBit = (metrics.totalRxBytes > 0) ? 
+        energyConsumed / (metrics.totalRxBytes * 8.0) : 0.0;
+}
+
+void MetricsCollector::UpdateReadingMetrics(uint64_t readingsDelivered, double readingEnergy,
+                                            uint64_t cryptoOperations) {
+    metrics.readingsDelivered = readingsDelivered;
+    metrics.energyPerReading = (readingsDelivered > 0) ? 
+        readingEnergy / readingsDelivered : 0.0;
+    metrics.cryptoOpsPerReading = (readingsDelivered > 0) ? 
+        (double)cryptoOperations / readingsDelivered : 0.0;
+}
+
+void MetricsCollector::UpdateDutyCycleMetrics(double energySaved, double addedLatency) {
+    metrics.dutyCycleEnergySaved = energySaved;
+    metrics.dutyCycleAddedLatency = addedLatency;
+    dutyCycled = true;
 }
 
 void MetricsCollector::UpdateNodeDeathMetrics(double deathTime, uint32_t nodeId, uint32_t totalNodes) {
@@ -99,6 +120,22 @@ void MetricsCollector::UpdateNodeDeathMetrics(double deathTime, uint32_t nodeId,
     CalculateDerivedMetrics(totalNodes);
 }
 
+void MetricsCollector::UpdateCoverageMetrics(double coverage, double kCoverage, uint32_t k) {
+    metrics.networkCoverage = coverage;
+    metrics.kCoverage = kCoverage;
+    metrics.coverageK = k;
+    coverageMeasured = true;
+}
+
+void MetricsCollector::UpdateConnectivityMetrics(double sinkReachable, double largestComponent,
+                                                 uint32_t components, double partitionTime) {
+    metrics.connectivityRatio = sinkReachable;
+    metrics.largestComponentRatio = largestComponent;
+    metrics.componentCount = components;
+    metrics.partitionTime = partitionTime;
+    connectivityMeasured = true;
+}
+
 void MetricsCollector::UpdateCryptoMetrics(uint32_t encrypted, uint32_t decrypted) {
     metrics.cryptoEncrypted = encrypted;
     metrics.cryptoDecrypted = decrypted;
@@ -117,12 +154,17 @@ void MetricsCollector::CalculateJitterMetrics(const std::vector<double>& jitterS
 }
 
 void MetricsCollector::CalculateDerivedMetrics(uint32_t totalNodes) {
-    // Calculate connectivity ratio (simplified)
-    metrics.connectivityRatio = (totalNodes > 0) ? 
+    // Geometric coverage and graph connectivity come from their trackers;
+    // the alive fraction is only a stand-in when they were not run
+    double aliveRatio = (totalNodes > 0) ? 
         (double)metrics.aliveNodeCount / totalNodes * 100 : 0.0;
     
-    // Calculate network coverage (simplified)
-    metrics.networkCoverage = metrics.connectivityRatio * 0.8; // Assuming 80% of nodes provide coverage
+    if (!connectivityMeasured) {
+        metrics.connectivityRatio = aliveRatio;
+    }
+    if (!coverageMeasured) {
+        metrics.networkCoverage = aliveRatio;
+    }
     
     // Calculate average node lifetime
     if (!nodeDeathTimes.empty()) {
@@ -182,8 +224,23 @@ void MetricsCollector::PrintComprehensiveMetrics() const {
     std::cout << "├─ Energy per Node:        " << metrics.energyPerNode << " J" << std::endl;
     std::cout << "├─ Energy Efficiency:      " << std::fixed << std::setprecision(2) 
               << metrics.energyEfficiency << " packets/J" << std::endl;
-    std::cout << "└─ Network Lifetime:       " << std::fixed << std::setprecision(2) 
+    std::cout << "├─ Energy per Bit:         " << std::fixed << std::setprecision(3) 
+              << metrics.energyPerBit * 1e6 << " µJ/bit" << std::endl;
+    if (metrics.readingsDelivered > 0) {
+        std::cout << "├─ Energy per Reading:     " << std::fixed << std::setprecision(2) 
+                  << metrics.energyPerReading * 1e3 << " mJ (" << metrics.readingsDelivered 
+                  << " readings, " << metrics.cryptoOpsPerReading << " crypto ops each)" << std::endl;
+    }
+    if (dutyCycled) {
+        std::cout << "├─ Duty-Cycle Saving:      " << std::fixed << std::setprecision(3)
+                  << metrics.dutyCycleEnergySaved << " J for +" << std::setprecision(4)
+                  << metrics.dutyCycleAddedLatency << " s latency" << std::endl;
+    }
+    std::cout << "├─ Network Lifetime:       " << std::fixed << std::setprecision(2) 
               << metrics.networkLifetime << " s" << std::endl;
+    std::cout << "└─ Partition Time:         ";
+    if (metrics.partitionTime >= 0) std::cout << metrics.partitionTime << " s" << std::endl;
+    else std::cout << "not partitioned" << std::endl;
     
     std::cout << "\n\033[1;33m💀 NETWORK SURVIVABILITY:\033[0m" << std::endl;
     std::cout << "├─ First Node Death Time:  " << std::fixed << std::setprecision(2) 
@@ -193,9 +250,16 @@ void MetricsCollector::PrintComprehensiveMetrics() const {
     std::cout << "├─ Node Survival Rate:     " << std::fixed << std::setprecision(2) 
               << metrics.nodeSurvivalRate << "%" << std::endl;
     std::cout << "├─ Network Coverage:       " << metrics.networkCoverage << "%" << std::endl;
+    if (coverageMeasured) {
+        std::cout << "├─ " << metrics.coverageK << "-Coverage:             " << metrics.kCoverage << "%" << std::endl;
+    }
     std::cout << "├─ Alive Nodes:            " << metrics.aliveNodeCount << std::endl;
     std::cout << "├─ Connectivity Ratio:     " << std::fixed << std::setprecision(2) 
               << metrics.connectivityRatio << "%" << std::endl;
+    if (connectivityMeasured) {
+        std::cout << "├─ Largest Component:      " << metrics.largestComponentRatio << "% ("
+                  << metrics.componentCount << " components)" << std::endl;
+    }
     std::cout << "└─ Survivability Index:    " << std::fixed << std::setprecision(3) 
               << metrics.networkSurvivabilityIndex << "/1.0" << std::endl;
     
@@ -237,7 +301,16 @@ void MetricsCollector::ExportMetricsToCSV(const std::string& filename) const {
     csvFile << "TotalEnergyConsumed," << metrics.totalEnergyConsumed << ",J\n";
     csvFile << "EnergyPerNode," << metrics.energyPerNode << ",J\n";
     csvFile << "EnergyEfficiency," << metrics.energyEfficiency << ",packets/J\n";
+    csvFile << "EnergyPerBit," << metrics.energyPerBit << ",J/bit\n";
+    csvFile << "ReadingsDelivered," << metrics.readingsDelivered << ",readings\n";
+    csvFile << "EnergyPerReading," << metrics.energyPerReading << ",J\n";
+    csvFile << "CryptoOpsPerReading," << metrics.cryptoOpsPerReading << ",ops\n";
+    if (dutyCycled) {
+        csvFile << "DutyCycleEnergySaved," << metrics.dutyCycleEnergySaved << ",J\n";
+        csvFile << "DutyCycleAddedLatency," << metrics.dutyCycleAddedLatency << ",s\n";
+    }
     csvFile << "NetworkLifetime," << metrics.networkLifetime << ",s\n";
+    csvFile << "PartitionTime," << metrics.partitionTime << ",s\n";
     
     // Survivability metrics
     csvFile << "FirstNodeDeathTime," << metrics.firstNodeDeathTime << ",s\n";
@@ -245,8 +318,16 @@ void MetricsCollector::ExportMetricsToCSV(const std::string& filename) const {
     csvFile << "AverageNodeLifetime," << metrics.averageNodeLifetime << ",s\n";
     csvFile << "NodeSurvivalRate," << metrics.nodeSurvivalRate << ",%\n";
     csvFile << "NetworkCoverage," << metrics.networkCoverage << ",%\n";
+    if (coverageMeasured) {
+        csvFile << "KCoverage," << metrics.kCoverage << ",%\n";
+        csvFile << "CoverageK," << metrics.coverageK << ",nodes\n";
+    }
     csvFile << "AliveNodeCount," << metrics.aliveNodeCount << ",nodes\n";
     csvFile << "ConnectivityRatio," << metrics.connectivityRatio << ",%\n";
+    if (connectivityMeasured) {
+        csvFile << "LargestComponentRatio," << metrics.largestComponentRatio << ",%\n";
+        csvFile << "ComponentCount," << metrics.componentCount << ",components\n";
+    }
     csvFile << "NetworkSurvivabilityIndex," << metrics.networkSurvivabilityIndex << ",index\n";
     
     // Crypto metrics
@@ -1,102 +1,186 @@
 #include "node_monitor.h"
 #include "event_emitter.h"
+#include "frame_emitter.h"
+#include "coverage_engine.h"
+#include "connectivity_tracker.h"
 #include <fstream>
 #include <algorithm>
 #include <cmath>
 
-NodeMonitor::NodeMonitor() : networkStartTime(0.0), totalNodes(0), areaSize(400.0) {}
+namespace {
 
-void NodeMonitor::InitializeNodes(uint32_t nodeCount, double initialEnergy) {
-    totalNodes = nodeCount;
-    nodeStatuses.resize(nodeCount);
+std::vector<std::string>& DeathCauseLabels() {
+    // Indexed by DeathCause; interned causes are appended.
+    static std::vector<std::string> labels = {
+        "", "Energy Depletion", "Simulated Failure", "Unknown"
+    };
+    return labels;
+}
+
+} // namespace
+
+NodeMonitor::NodeMonitor()
+    : aliveCount(0), deathTimeSum(0.0), timedDeathCount(0),
+      networkStartTime(0.0), totalNodes(0), areaSize(400.0),
+      coverageEngine(nullptr), connectivityTracker(nullptr) {}
+
+uint8_t NodeMonitor::InternDeathCause(const std::string& label) {
+    std::vector<std::string>& labels = DeathCauseLabels();
     
-    for (uint32_t i = 0; i < nodeCount; ++i) {
-        nodeStatuses[i] = {
-            i,                     // nodeId
-            initialEnergy,         // initialEnergy
-            initialEnergy,         // remainingEnergy
-            true,                  // isAlive
-            -1.0,                  // deathTime
-            "",                    // deathCause
-            0,                     // packetsSent
-            0,                     // packetsReceived
-            0.0,                   // lastActivityTime
-            0.0,                   // jitterSum
-            0,                     // jitterCount
-            0.0,                   // positionX
-            0.0                    // positionY
-        };
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (labels[i] == label) return static_cast<uint8_t>(i);
+    }
+    if (labels.size() > UINT8_MAX) {
+        return static_cast<uint8_t>(DeathCause::Unknown);
     }
     
+    labels.push_back(label);
+    return static_cast<uint8_t>(labels.size() - 1);
+}
+
+const std::string& NodeMonitor::DeathCauseLabel(uint8_t cause) {
+    const std::vector<std::string>& labels = DeathCauseLabels();
+    return cause < labels.size() ? labels[cause] : labels[static_cast<uint8_t>(DeathCause::Unknown)];
+}
+
+void NodeMonitor::InitializeNodes(uint32_t nodeCount, double energy) {
+    totalNodes = nodeCount;
+    
+    remainingEnergy.assign(nodeCount, energy);
+    alive.assign(nodeCount, 1);
+    packetsSent.assign(nodeCount, 0);
+    packetsReceived.assign(nodeCount, 0);
+    
+    initialEnergy.assign(nodeCount, energy);
+    deathTime.assign(nodeCount, -1.0);
+    deathCause.assign(nodeCount, static_cast<uint8_t>(DeathCause::None));
+    lastActivityTime.assign(nodeCount, 0.0);
+    jitterSum.assign(nodeCount, 0.0);
+    jitterCount.assign(nodeCount, 0);
+    positionX.assign(nodeCount, 0.0);
+    positionY.assign(nodeCount, 0.0);
+    
+    aliveCount = nodeCount;
+    deathTimeSum = 0.0;
+    timedDeathCount = 0;
+    deathTimeline.clear();
+    deathTimeline.reserve(nodeCount);
+    
     EventEmitter::Instance().EmitEvent("monitor_init", nodeCount);
 }
 
 void NodeMonitor::UpdateEnergy(uint32_t nodeId, double energyConsumed) {
-    if (nodeId >= nodeStatuses.size()) return;
+    if (nodeId >= totalNodes) return;
+    
+    SetRemainingEnergy(nodeId, remainingEnergy[nodeId] - energyConsumed);
     
-    nodeStatuses[nodeId].remainingEnergy -= energyConsumed;
-    nodeStatuses[nodeId].remainingEnergy = std::max(0.0, nodeStatuses[nodeId].remainingEnergy);
+    FrameEmitter& frames = FrameEmitter::Instance();
+    if (!frames.IsEnabled()) {
+        EventEmitter::Instance().EmitNodeEvent(nodeId, "energy_update", remainingEnergy[nodeId]);
+    }
+}
+
+void NodeMonitor::SetRemainingEnergy(uint32_t nodeId, double energy) {
+    if (nodeId >= totalNodes) return;
     
-    EventEmitter::Instance().EmitNodeEvent(nodeId, "energy_update", 
-                                          nodeStatuses[nodeId].remainingEnergy);
+    remainingEnergy[nodeId] = std::max(0.0, energy);
+    FrameEmitter::Instance().UpdateEnergy(nodeId, remainingEnergy[nodeId]);
 }
 
 void NodeMonitor::UpdatePacketCount(uint32_t nodeId, bool isSent) {
-    if (nodeId >= nodeStatuses.size() || !nodeStatuses[nodeId].isAlive) return;
+    if (nodeId >= totalNodes || !alive[nodeId]) return;
     
     if (isSent) {
-        nodeStatuses[nodeId].packetsSent++;
+        packetsSent[nodeId]++;
     } else {
-        nodeStatuses[nodeId].packetsReceived++;
+        packetsReceived[nodeId]++;
     }
     
-    nodeStatuses[nodeId].lastActivityTime = 
+    lastActivityTime[nodeId] = 
         EventEmitter::Instance().GetFirstNodeDeathTime(); // Using as timestamp proxy
 }
 
 void NodeMonitor::CheckNodeDeath(uint32_t nodeId, double currentTime, const std::string& cause) {
-    if (nodeId >= nodeStatuses.size() || !nodeStatuses[nodeId].isAlive) return;
+    CheckNodeDeath(nodeId, currentTime, static_cast<DeathCause>(InternDeathCause(cause)));
+}
+
+void NodeMonitor::CheckNodeDeath(uint32_t nodeId, double currentTime, DeathCause cause) {
+    if (nodeId >= totalNodes || !alive[nodeId]) return;
     
-    if (nodeStatuses[nodeId].remainingEnergy <= 0.05) { // Threshold for death
-        nodeStatuses[nodeId].isAlive = false;
-        nodeStatuses[nodeId].deathTime = currentTime;
-        nodeStatuses[nodeId].deathCause = cause;
+    if (remainingEnergy[nodeId] <= kDeathThreshold) {
+        alive[nodeId] = 0;
+        deathTime[nodeId] = currentTime;
+        deathCause[nodeId] = static_cast<uint8_t>(cause);
+        
+        aliveCount--;
+        if (currentTime > 0) {
+            deathTimeSum += currentTime;
+            timedDeathCount++;
+        }
+        // Deaths arrive in time order in a run; upper_bound keeps the
+        // timeline sorted if a caller ever reports one late.
+        std::pair<double, uint32_t> entry(currentTime, nodeId);
+        if (deathTimeline.empty() || deathTimeline.back() <= entry) {
+            deathTimeline.push_back(entry);
+        } else {
+            deathTimeline.insert(std::upper_bound(deathTimeline.begin(), deathTimeline.end(), entry), entry);
+        }
         
-        EventEmitter::Instance().LogNodeDeath(nodeId, currentTime, cause);
+        if (coverageEngine) {
+            coverageEngine->RemoveNode(nodeId);
+        }
+        if (connectivityTracker) {
+            connectivityTracker->RemoveNode(nodeId, currentTime);
+        }
+        
+        FrameEmitter::Instance().UpdateStatus(nodeId, "dead");
+        EventEmitter::Instance().LogNodeDeath(nodeId, currentTime,
+                                              DeathCauseLabel(deathCause[nodeId]));
     }
 }
 
 void NodeMonitor::RecordJitter(uint32_t nodeId, double jitter) {
-    if (nodeId >= nodeStatuses.size() || !nodeStatuses[nodeId].isAlive) return;
+    if (nodeId >= totalNodes || !alive[nodeId]) return;
     
-    nodeStatuses[nodeId].jitterSum += fabs(jitter);
-    nodeStatuses[nodeId].jitterCount++;
+    jitterSum[nodeId] += fabs(jitter);
+    jitterCount[nodeId]++;
 }
 
 void NodeMonitor::UpdatePosition(uint32_t nodeId, double x, double y) {
-    if (nodeId >= nodeStatuses.size()) return;
+    if (nodeId >= totalNodes) return;
     
-    nodeStatuses[nodeId].positionX = x;
-    nodeStatuses[nodeId].positionY = y;
+    positionX[nodeId] = x;
+    positionY[nodeId] = y;
 }
 
 NodeMonitor::NodeStatus NodeMonitor::GetNodeStatus(uint32_t nodeId) const {
-    if (nodeId < nodeStatuses.size()) {
-        return nodeStatuses[nodeId];
+    if (nodeId >= totalNodes) {
+        return NodeStatus();
     }
-    return NodeStatus();
-}
-
-std::vector<NodeMonitor::NodeStatus> NodeMonitor::GetAllNodeStatus() const {
-    return nodeStatuses;
+    
+    return {
+        nodeId,
+        initialEnergy[nodeId],
+        remainingEnergy[nodeId],
+        alive[nodeId] != 0,
+        deathTime[nodeId],
+        DeathCauseLabel(deathCause[nodeId]),
+        packetsSent[nodeId],
+        packetsReceived[nodeId],
+        lastActivityTime[nodeId],
+        jitterSum[nodeId],
+        jitterCount[nodeId],
+        positionX[nodeId],
+        positionY[nodeId]
+    };
 }
 
 bool NodeMonitor::IsNodeAlive(uint32_t nodeId) const {
-    return (nodeId < nodeStatuses.size()) ? nodeStatuses[nodeId].isAlive : false;
+    return (nodeId < totalNodes) ? alive[nodeId] != 0 : false;
 }
 
 double NodeMonitor::GetNodeRemainingEnergy(uint32_t nodeId) const {
-    return (nodeId < nodeStatuses.size()) ? nodeStatuses[nodeId].remainingEnergy : 0.0;
+    return (nodeId < totalNodes) ? remainingEnergy[nodeId] : 0.0;
 }
 
 double NodeMonitor::GetNetworkLifetime() const {
@@ -108,30 +192,19 @@ double NodeMonitor::GetNetworkLifetime() const {
 }
 
 double NodeMonitor::GetAverageNodeLifetime() const {
-    double totalLifetime = 0.0;
-    int deadNodes = 0;
-    
-    for (const auto& status : nodeStatuses) {
-        if (!status.isAlive && status.deathTime > 0) {
-            totalLifetime += status.deathTime;
-            deadNodes++;
-        }
-    }
-    
-    return (deadNodes > 0) ? totalLifetime / deadNodes : 0.0;
+    return (timedDeathCount > 0) ? deathTimeSum / timedDeathCount : 0.0;
 }
 
 uint32_t NodeMonitor::GetAliveNodeCount() const {
-    uint32_t alive = 0;
-    for (const auto& status : nodeStatuses) {
-        if (status.isAlive) alive++;
-    }
-    return alive;
+    return aliveCount;
 }
 
 double NodeMonitor::calculateCoverage() const {
+    if (coverageEngine && coverageEngine->IsConfigured()) {
+        return coverageEngine->GetCoverage();
+    }
+    
     // Simplified coverage calculation based on alive nodes
-    uint32_t aliveCount = GetAliveNodeCount();
     if (aliveCount == 0) return 0.0;
     
     // Assuming nodes are evenly distributed
@@ -145,28 +218,25 @@ double NodeMonitor::GetNetworkCoverage() const {
     return calculateCoverage();
 }
 
+double NodeMonitor::GetKCoverage() const {
+    return (coverageEngine && coverageEngine->IsConfigured()) ? coverageEngine->GetKCoverage() : 0.0;
+}
+
 double NodeMonitor::GetFirstNodeDeathTime() const {
-    double firstDeath = -1.0;
-    for (const auto& status : nodeStatuses) {
-        if (!status.isAlive && status.deathTime > 0) {
-            if (firstDeath < 0 || status.deathTime < firstDeath) {
-                firstDeath = status.deathTime;
-            }
-        }
-    }
-    return firstDeath;
+    return deathTimeline.empty() ? -1.0 : deathTimeline.front().first;
 }
 
 double NodeMonitor::GetLastNodeDeathTime() const {
-    double lastDeath = -1.0;
-    for (const auto& status : nodeStatuses) {
-        if (!status.isAlive && status.deathTime > 0) {
-            if (status.deathTime > lastDeath) {
-                lastDeath = status.deathTime;
-            }
-        }
-    }
-    return lastDeath;
+    return deathTimeline.empty() ? -1.0 : deathTimeline.back().first;
+}
+
+double NodeMonitor::GetTimeUntilDeadFraction(double fraction) const {
+    if (totalNodes == 0) return -1.0;
+    
+    fraction = std::max(0.0, std::min(1.0, fraction));
+    size_t needed = std::max<size_t>(1, static_cast<size_t>(std::ceil(fraction * totalNodes)));
+    
+    return (deathTimeline.size() >= needed) ? deathTimeline[needed - 1].first : -1.0;
 }
 
 void NodeMonitor::PrintNodeStatusTable() const {
@@ -181,22 +251,22 @@ void NodeMonitor::PrintNodeStatusTable() const {
               << std::setw(15) << "Cause" << std::endl;
     std::cout << "\033[1;37m" << std::string(90, '-') << "\033[0m" << std::endl;
     
-    for (const auto& status : nodeStatuses) {
-        std::cout << std::left << std::setw(6) << status.nodeId;
+    for (uint32_t i = 0; i < totalNodes; ++i) {
+        std::cout << std::left << std::setw(6) << i;
         
-        if (status.isAlive) {
+        if (alive[i]) {
             std::cout << "\033[32m" << std::setw(8) << "ALIVE" << "\033[0m";
         } else {
             std::cout << "\033[31m" << std::setw(8) << "DEAD" << "\033[0m";
         }
         
-        std::cout << std::setw(10) << std::fixed << std::setprecision(2) << status.remainingEnergy
-                  << std::setw(8) << status.packetsSent
-                  << std::setw(10) << status.packetsReceived;
+        std::cout << std::setw(10) << std::fixed << std::setprecision(2) << remainingEnergy[i]
+                  << std::setw(8) << packetsSent[i]
+                  << std::setw(10) << packetsReceived[i];
         
-        if (status.deathTime > 0) {
-            std::cout << std::setw(12) << std::fixed << std::setprecision(1) << status.deathTime
-                      << std::setw(15) << status.deathCause.substr(0, 12);
+        if (deathTime[i] > 0) {
+            std::cout << std::setw(12) << std::fixed << std::setprecision(1) << deathTime[i]
+                      << std::setw(15) << DeathCauseLabel(deathCause[i]).substr(0, 12);
         } else {
             std::cout << std::setw(12) << "N/A" 
                       << std::setw(15) << "N/A";
@@ -206,9 +276,9 @@ void NodeMonitor::PrintNodeStatusTable() const {
     }
     
     std::cout << "\033[1;37m" << std::string(90, '=') << "\033[0m" << std::endl;
-    std::cout << "Alive Nodes: " << GetAliveNodeCount() << "/" << totalNodes 
+    std::cout << "Alive Nodes: " << aliveCount << "/" << totalNodes 
               << " (" << std::fixed << std::setprecision(1) 
-              << (double)GetAliveNodeCount()/totalNodes*100 << "%)" << std::endl;
+              << (double)aliveCount/totalNodes*100 << "%)" << std::endl;
 }
 
 void NodeMonitor::PrintNetworkLifetimeMetrics() const {
@@ -227,8 +297,21 @@ void NodeMonitor::PrintNetworkLifetimeMetrics() const {
         std::cout << "Network Lifetime:   " << (lastDeath - firstDeath) << "s" << std::endl;
         std::cout << "Avg Node Lifetime:  " << std::fixed << std::setprecision(2) 
                   << GetAverageNodeLifetime() << "s" << std::endl;
+        
+        double halfDead = GetHalfNodesDeadTime();
+        double allDead = GetAllNodesDeadTime();
+        std::cout << "Half Nodes Dead:    ";
+        if (halfDead >= 0) std::cout << halfDead << "s" << std::endl;
+        else std::cout << "not reached" << std::endl;
+        std::cout << "All Nodes Dead:     ";
+        if (allDead >= 0) std::cout << allDead << "s" << std::endl;
+        else std::cout << "not reached" << std::endl;
         std::cout << "Network Coverage:   " << std::fixed << std::setprecision(1) 
                   << GetNetworkCoverage() << "%" << std::endl;
+        if (coverageEngine && coverageEngine->IsConfigured()) {
+            std::cout << coverageEngine->GetK() << "-Coverage:         " << std::fixed << std::setprecision(1)
+                      << GetKCoverage() << "%" << std::endl;
+        }
         std::cout << "Alive Nodes:        " << GetAliveNodeCount() << "/" << totalNodes 
                   << std::endl;
     }
@@ -245,16 +328,17 @@ void NodeMonitor::ExportNodeData(const std::string& filename) const {
     
     file << "NodeID,Status,RemainingEnergy,PacketsSent,PacketsReceived,DeathTime,DeathCause,PositionX,PositionY\n";
     
-    for (const auto& status : nodeStatuses) {
-        file << status.nodeId << ","
-             << (status.isAlive ? "ALIVE" : "DEAD") << ","
-             << std::fixed << std::setprecision(3) << status.remainingEnergy << ","
-             << status.packetsSent << ","
-             << status.packetsReceived << ","
-             << (status.deathTime > 0 ? std::to_string(status.deathTime) : "N/A") << ","
-             << (status.deathCause.empty() ? "N/A" : status.deathCause) << ","
-             << status.positionX << ","
-             << status.positionY << "\n";
+    for (uint32_t i = 0; i < totalNodes; ++i) {
+        const std::string& cause = DeathCauseLabel(deathCause[i]);
+        file << i << ","
+             << (alive[i] ? "ALIVE" : "DEAD") << ","
+             << std::fixed << std::setprecision(3) << remainingEnergy[i] << ","
+             << packetsSent[i] << ","
+             << packetsReceived[i] << ","
+             << (deathTime[i] > 0 ? std::to_string(deathTime[i]) : "N/A") << ","
+             << (cause.empty() ? "N/A" : cause) << ","
+             << positionX[i] << ","
+             << positionY[i] << "\n";
     }
     
     file.close();
@@ -0,0 +1,131 @@
+#include "online_optimizer.h"
+#include "memostp_protocol.h"
+#include "tx_power_controller.h"
+#include "duty_cycle_scheduler.h"
+#include "cluster_manager.h"
+#include "event_emitter.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+OnlineOptimizer::OnlineOptimizer()
+    : m_protocol(nullptr), m_monitor(nullptr), m_txPower(nullptr), m_dutyCycle(nullptr),
+      m_clusters(nullptr), m_nextTrigger(0.7), m_thresholdStep(0.1), m_iterations(3),
+      m_budget(8), m_interval(1.0), m_runs(0), m_evaluations(0), m_runEvaluations(0),
+      m_ticks(0), m_runStart(0.0), m_sliceTime(0.0), m_maxSliceTime(0.0) {}
+
+void OnlineOptimizer::Configure(EnhancedMEMOSTPProtocol& protocol, NodeMonitor& monitor,
+                                double aliveThreshold, double thresholdStep, int iterations,
+                                uint32_t budget) {
+    m_protocol = &protocol;
+    m_monitor = &monitor;
+    m_nextTrigger = std::max(0.0, std::min(1.0, aliveThreshold));
+    m_thresholdStep = std::max(0.0, thresholdStep);
+    m_iterations = std::max(1, iterations);
+    m_budget = std::max(1u, budget);
+}
+
+void OnlineOptimizer::Attach(TxPowerController* txPower, DutyCycleScheduler* dutyCycle,
+                             ClusterManager* clusters) {
+    m_txPower = txPower;
+    m_dutyCycle = dutyCycle;
+    m_clusters = clusters;
+}
+
+void OnlineOptimizer::Start(double startTime, double tickInterval) {
+    if (!m_protocol || !m_monitor) return;
+    
+    m_interval = std::max(0.01, tickInterval);
+    Simulator::Schedule(Seconds(startTime), &OnlineOptimizer::Tick, this);
+}
+
+void OnlineOptimizer::Tick() {
+    auto sliceStart = std::chrono::steady_clock::now();
+    EventEmitter& emitter = EventEmitter::Instance();
+    
+    if (!m_protocol->isReoptimizing()) {
+        uint32_t total = m_monitor->GetNodeCount();
+        double aliveFraction = (total > 0) ? (double)m_monitor->GetAliveNodeCount() / total : 1.0;
+        if (aliveFraction < m_nextTrigger) {
+            // One run per crossing; the next one waits for a further drop
+            m_nextTrigger = aliveFraction - m_thresholdStep;
+            m_runStart = Simulator::Now().GetSeconds();
+            m_runEvaluations = 0;
+            m_protocol->setNetworkState(m_monitor->AliveColumn(), m_monitor->RemainingEnergyColumn(),
+                                        m_monitor->InitialEnergyColumn());
+            m_protocol->beginReoptimization(m_iterations);
+            emitter.EmitEvent("reoptimization_start", m_runs, -1, m_iterations);
+            std::cout << "\033[33m🔁 Re-optimizing at t=" << std::fixed << std::setprecision(1)
+                      << m_runStart << "s (" << std::setprecision(0) << aliveFraction * 100.0
+                      << "% alive)\033[0m" << std::endl;
+        }
+    }
+    
+    if (m_protocol->isReoptimizing()) {
+        bool finished = m_protocol->continueReoptimization(m_budget);
+        m_runEvaluations = m_protocol->getOptimizerEvaluations();
+        if (finished) {
+            m_evaluations += m_runEvaluations;
+            m_runs++;
+            Apply();
+            emitter.EmitEvent("reoptimization_complete", m_runs);
+            std::cout << "\033[32m🔁 Re-optimized in " << std::fixed << std::setprecision(1)
+                      << Simulator::Now().GetSeconds() - m_runStart << " sim s (" << m_runEvaluations
+                      << " evaluations): EW " << std::setprecision(3) << m_protocol->getEnergyWeight()
+                      << ", PC " << m_protocol->getPowerControl() << ", SR "
+                      << m_protocol->getSleepRatio() << "\033[0m" << std::endl;
+        }
+        
+        double slice = std::chrono::duration<double>(std::chrono::steady_clock::now() - sliceStart).count();
+        m_sliceTime += slice;
+        m_maxSliceTime = std::max(m_maxSliceTime, slice);
+        m_ticks++;
+    }
+    
+    Simulator::Schedule(Seconds(m_interval), &OnlineOptimizer::Tick, this);
+}
+
+void OnlineOptimizer::Apply() {
+    EventEmitter& emitter = EventEmitter::Instance();
+    const ParameterMatrix& nodeParams = m_protocol->getNodeParameters();
+    bool perNode = m_protocol->getRegionCount() > 1;
+    
+    if (m_txPower) {
+        if (perNode) {
+            m_txPower->SetPowerControl(nodeParams.CopyColumn(ParameterMatrix::PowerControl));
+        } else {
+            m_txPower->SetPowerControl(m_protocol->getPowerControl());
+        }
+        emitter.EmitMetric("tx_power_margin_db", m_txPower->GetTargetMargin());
+    }
+    if (m_dutyCycle && m_dutyCycle->IsEnabled()) {
+        if (perNode) {
+            m_dutyCycle->SetSleepRatio(nodeParams.CopyColumn(ParameterMatrix::SleepRatio));
+        } else {
+            m_dutyCycle->SetSleepRatio(m_protocol->getSleepRatio());
+        }
+        emitter.EmitMetric("duty_cycle_sleep_ratio", m_dutyCycle->GetSleepRatio());
+    }
+    if (m_clusters) {
+        if (perNode) {
+            m_clusters->SetEnergyWeight(nodeParams.CopyColumn(ParameterMatrix::EnergyWeight));
+        } else {
+            m_clusters->SetEnergyWeight(m_protocol->getEnergyWeight());
+        }
+    }
+}
+
+void OnlineOptimizer::PrintReport() const {
+    std::cout << "\n\033[1;33m🔁 ONLINE RE-OPTIMIZATION:\033[0m" << std::endl;
+    std::cout << "├─ Runs:                   " << m_runs << " x " << m_iterations
+              << " iterations" << std::endl;
+    std::cout << "├─ Evaluations:            " << m_evaluations << " (at most " << m_budget
+              << " per " << std::fixed << std::setprecision(2) << m_interval << " s tick)" << std::endl;
+    std::cout << "├─ Optimizer Ticks:        " << m_ticks << std::endl;
+    std::cout << "└─ Wall Time per Tick:     " << std::setprecision(2)
+              << (m_ticks > 0 ? m_sliceTime / m_ticks * 1000.0 : 0.0) << " ms avg, "
+              << m_maxSliceTime * 1000.0 << " ms max" << std::endl;
+}
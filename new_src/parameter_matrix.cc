@@ -0,0 +1,130 @@
+#include "parameter_matrix.h"
+#include "snake_optimizer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// How far the per-node targets move between the sink and the edge
+constexpr double kSkew = 0.1;
+}
+
+ParameterMatrix::ParameterMatrix() : nodeCount(0), regionCount(1) {}
+
+void ParameterMatrix::AssignRegions(ColumnView<double> x, ColumnView<double> y, uint32_t sinkId,
+                                    uint32_t regions) {
+    nodeCount = (uint32_t)std::min(x.size(), y.size());
+    regionCount = std::max(1u, std::min(regions, std::max(1u, nodeCount)));
+    
+    double sinkX = sinkId < nodeCount ? x[sinkId] : 0.0;
+    double sinkY = sinkId < nodeCount ? y[sinkId] : 0.0;
+    distance.assign(nodeCount, 0.0);
+    double farthest = 0.0;
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        distance[i] = std::hypot(x[i] - sinkX, y[i] - sinkY);
+        farthest = std::max(farthest, distance[i]);
+    }
+    
+    region.assign(nodeCount, 0);
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        if (farthest > 0.0) distance[i] /= farthest;
+        region[i] = std::min(regionCount - 1, (uint32_t)(distance[i] * regionCount));
+    }
+    
+    drain.assign(nodeCount, 0.0);
+    alive.assign(nodeCount, 1);
+    values.assign((size_t)kColumns * nodeCount, 0.0);
+    Expand(EnhancedSnakeOptimizer::getDefaultParams());
+}
+
+void ParameterMatrix::SetNodeState(ColumnView<uint8_t> aliveNodes, ColumnView<double> remaining,
+                                   ColumnView<double> initial) {
+    size_t known = std::min({(size_t)nodeCount, aliveNodes.size(), remaining.size(), initial.size()});
+    for (size_t i = 0; i < known; i++) {
+        alive[i] = aliveNodes[i] ? 1 : 0;
+        drain[i] = initial[i] > 0.0 ? std::max(0.0, std::min(1.0, 1.0 - remaining[i] / initial[i])) : 0.0;
+    }
+}
+
+double ParameterMatrix::GetMeanDrain() const {
+    double sum = 0.0;
+    uint32_t counted = 0;
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        sum += alive[i] ? drain[i] : 0.0;
+        counted += alive[i];
+    }
+    return counted > 0 ? sum / counted : 0.0;
+}
+
+void ParameterMatrix::Expand(const std::vector<double>& regionParams) {
+    values.resize((size_t)kColumns * nodeCount);
+    Expand(regionParams, values.data());
+}
+
+void ParameterMatrix::Expand(const std::vector<double>& regionParams, double* out) const {
+    // A short vector (e.g. one global triple) repeats over the regions
+    const std::vector<double>& defaults = EnhancedSnakeOptimizer::getDefaultParams();
+    for (uint32_t c = 0; c < kColumns; c++) {
+        double* column = out + (size_t)c * nodeCount;
+        for (uint32_t i = 0; i < nodeCount; i++) {
+            size_t index = (size_t)region[i] * kColumns + c;
+            column[i] = index < regionParams.size() ? regionParams[index]
+                      : c < regionParams.size() ? regionParams[c] : defaults[c];
+        }
+    }
+}
+
+std::vector<double> ParameterMatrix::CopyColumn(Column column) const {
+    ColumnView<double> view = GetColumn(column);
+    return std::vector<double>(view.begin(), view.end());
+}
+
+double ParameterMatrix::GetMean(Column column) const {
+    if (nodeCount == 0) return EnhancedSnakeOptimizer::getDefaultParams()[column];
+    double sum = 0.0;
+    for (double value : GetColumn(column)) sum += value;
+    return sum / nodeCount;
+}
+
+void ParameterMatrix::ScoreNodes(const double* values, const double* distance, const double* drain,
+                                 size_t nodes, double* nodeScores) {
+    const double* energyWeight = values;
+    const double* powerControl = values + nodes;
+    const double* sleepRatio = values + 2 * nodes;
+    
+    for (size_t i = 0; i < nodes; i++) {
+        double skew = kSkew * (1.0 - 2.0 * distance[i]);   // +kSkew at the sink, -kSkew at the edge
+        double save = kDrainShift * drain[i];               // 0 full, kDrainShift empty
+        double ew = energyWeight[i];
+        double pc = powerControl[i];
+        double sr = sleepRatio[i];
+        
+        double score = 3.0 - std::fabs(ew - (0.6 + skew + save))
+                           - std::fabs(pc - (0.75 + skew + save))
+                           - std::fabs(sr - (0.3 - skew + save));
+        
+        // Same out-of-range penalty as the global model. One select per
+        // bound (never both) instead of ||, which would branch.
+        score *= (ew < 0.4 ? 0.5 : 1.0) * (ew > 0.8 ? 0.5 : 1.0);
+        score *= (pc < 0.4 ? 0.5 : 1.0) * (pc > 0.9 ? 0.5 : 1.0);
+        score *= (sr < 0.1 ? 0.5 : 1.0) * (sr > 0.5 ? 0.5 : 1.0);
+        nodeScores[i] = score;
+    }
+}
+
+double ParameterMatrix::Score(const std::vector<double>& regionParams, std::vector<double>& scratch) const {
+    if (nodeCount == 0) return 0.0;
+    
+    scratch.resize((size_t)(kColumns + 1) * nodeCount);
+    double* matrix = scratch.data();
+    double* nodeScores = matrix + (size_t)kColumns * nodeCount;
+    Expand(regionParams, matrix);
+    ScoreNodes(matrix, distance.data(), drain.data(), nodeCount, nodeScores);
+    
+    double sum = 0.0;
+    uint32_t counted = 0;
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        sum += alive[i] ? nodeScores[i] : 0.0;
+        counted += alive[i];
+    }
+    return counted > 0 ? sum / counted : 0.0;
+}
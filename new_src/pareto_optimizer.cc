@@ -0,0 +1,355 @@
+#include "pareto_optimizer.h"
+#include "snake_optimizer.h"
+#include "event_emitter.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <cmath>
+
+namespace {
+// Distribution indices (Deb & Agrawal): larger keeps children closer to parents
+constexpr double kCrossoverEta = 15.0;
+constexpr double kMutationEta = 20.0;
+constexpr double kCrossoverRate = 0.9;
+}
+
+ParetoOptimizer::ParetoOptimizer(const std::vector<Objective>& objectives, ObjectiveFunction evaluate)
+    : objectiveSpec(objectives), evaluateBatch(evaluate), populationSize(30),
+      rng(0, 0), evaluations(0) {}
+
+void ParetoOptimizer::setPopulationSize(uint32_t size) {
+    size = std::max(4u, size);
+    populationSize = size + (size % 2);
+}
+
+double ParetoOptimizer::cost(const Solution& s, size_t objective) const {
+    return objectiveSpec[objective].maximize ? -s.objectives[objective] : s.objectives[objective];
+}
+
+bool ParetoOptimizer::dominates(const Solution& a, const Solution& b) const {
+    bool strictlyBetter = false;
+    for (size_t k = 0; k < objectiveSpec.size(); k++) {
+        double ca = cost(a, k);
+        double cb = cost(b, k);
+        if (ca > cb) return false;
+        if (ca < cb) strictlyBetter = true;
+    }
+    return strictlyBetter;
+}
+
+void ParetoOptimizer::assignCrowding(std::vector<Solution>& solutions,
+                                     const std::vector<size_t>& members) const {
+    for (size_t i : members) {
+        solutions[i].crowding = 0.0;
+    }
+    if (members.size() <= 2) {
+        for (size_t i : members) {
+            solutions[i].crowding = std::numeric_limits<double>::infinity();
+        }
+        return;
+    }
+    
+    std::vector<size_t> order(members);
+    for (size_t k = 0; k < objectiveSpec.size(); k++) {
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return cost(solutions[a], k) < cost(solutions[b], k);
+        });
+        
+        double low = cost(solutions[order.front()], k);
+        double high = cost(solutions[order.back()], k);
+        solutions[order.front()].crowding = std::numeric_limits<double>::infinity();
+        solutions[order.back()].crowding = std::numeric_limits<double>::infinity();
+        if (high - low <= 0.0) continue;
+        
+        for (size_t j = 1; j + 1 < order.size(); j++) {
+            solutions[order[j]].crowding +=
+                (cost(solutions[order[j + 1]], k) - cost(solutions[order[j - 1]], k)) / (high - low);
+        }
+    }
+}
+
+void ParetoOptimizer::rankAndCrowd(std::vector<Solution>& solutions) const {
+    // Fast non-dominated sort (Deb et al. 2002)
+    size_t n = solutions.size();
+    std::vector<std::vector<size_t>> dominated(n);
+    std::vector<uint32_t> dominators(n, 0);
+    std::vector<size_t> current;
+    
+    for (size_t p = 0; p < n; p++) {
+        for (size_t q = p + 1; q < n; q++) {
+            if (dominates(solutions[p], solutions[q])) {
+                dominated[p].push_back(q);
+                dominators[q]++;
+            } else if (dominates(solutions[q], solutions[p])) {
+                dominated[q].push_back(p);
+                dominators[p]++;
+            }
+        }
+    }
+    for (size_t p = 0; p < n; p++) {
+        if (dominators[p] == 0) current.push_back(p);
+    }
+    
+    uint32_t rank = 0;
+    while (!current.empty()) {
+        std::vector<size_t> next;
+        for (size_t p : current) {
+            solutions[p].rank = rank;
+            for (size_t q : dominated[p]) {
+                if (--dominators[q] == 0) next.push_back(q);
+            }
+        }
+        assignCrowding(solutions, current);
+        current.swap(next);
+        rank++;
+    }
+}
+
+const ParetoOptimizer::Solution& ParetoOptimizer::tournament(const std::vector<Solution>& pool) {
+    std::uniform_int_distribution<size_t> pickIndex(0, pool.size() - 1);
+    const Solution& a = pool[pickIndex(rng)];
+    const Solution& b = pool[pickIndex(rng)];
+    if (a.rank != b.rank) return a.rank < b.rank ? a : b;
+    return a.crowding >= b.crowding ? a : b;
+}
+
+void ParetoOptimizer::breed(const Solution& a, const Solution& b,
+                            std::vector<double>& childA, std::vector<double>& childB) {
+    const std::vector<double>& lower = EnhancedSnakeOptimizer::getLowerBounds();
+    const std::vector<double>& upper = EnhancedSnakeOptimizer::getUpperBounds();
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    
+    childA = a.params;
+    childB = b.params;
+    if (unit(rng) > kCrossoverRate) return;
+    
+    // Simulated binary crossover, per parameter with probability 0.5
+    for (size_t d = 0; d < childA.size(); d++) {
+        if (unit(rng) > 0.5 || std::fabs(a.params[d] - b.params[d]) < 1e-12) continue;
+        
+        double u = unit(rng);
+        double beta = (u <= 0.5) ? std::pow(2.0 * u, 1.0 / (kCrossoverEta + 1.0))
+                                 : std::pow(1.0 / (2.0 * (1.0 - u)), 1.0 / (kCrossoverEta + 1.0));
+        double mean = 0.5 * (a.params[d] + b.params[d]);
+        double half = 0.5 * beta * (b.params[d] - a.params[d]);
+        childA[d] = std::max(lower[d], std::min(upper[d], mean - half));
+        childB[d] = std::max(lower[d], std::min(upper[d], mean + half));
+    }
+}
+
+void ParetoOptimizer::mutate(std::vector<double>& params) {
+    const std::vector<double>& lower = EnhancedSnakeOptimizer::getLowerBounds();
+    const std::vector<double>& upper = EnhancedSnakeOptimizer::getUpperBounds();
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double rate = 1.0 / params.size();
+    
+    // Polynomial mutation
+    for (size_t d = 0; d < params.size(); d++) {
+        if (unit(rng) > rate) continue;
+        double u = unit(rng);
+        double delta = (u < 0.5) ? std::pow(2.0 * u, 1.0 / (kMutationEta + 1.0)) - 1.0
+                                 : 1.0 - std::pow(2.0 * (1.0 - u), 1.0 / (kMutationEta + 1.0));
+        params[d] = std::max(lower[d], std::min(upper[d], params[d] + delta * (upper[d] - lower[d])));
+    }
+}
+
+void ParetoOptimizer::evaluate(std::vector<Solution>& solutions) {
+    std::vector<std::vector<double>> candidates(solutions.size());
+    for (size_t i = 0; i < solutions.size(); i++) {
+        candidates[i] = solutions[i].params;
+    }
+    
+    std::vector<std::vector<double>> values;
+    evaluateBatch(candidates, values);
+    for (size_t i = 0; i < solutions.size(); i++) {
+        solutions[i].objectives = (i < values.size()) ? values[i] : std::vector<double>();
+        solutions[i].objectives.resize(objectiveSpec.size(), 0.0);
+    }
+    evaluations += solutions.size();
+}
+
+void ParetoOptimizer::extractFront() {
+    front.clear();
+    for (const Solution& s : population) {
+        if (s.rank != 0) continue;
+        bool duplicate = false;
+        for (const Solution& f : front) {
+            if (f.params == s.params) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate) front.push_back(s);
+    }
+    
+    std::sort(front.begin(), front.end(), [&](const Solution& a, const Solution& b) {
+        return cost(a, 0) < cost(b, 0);
+    });
+}
+
+const std::vector<ParetoOptimizer::Solution>& ParetoOptimizer::optimize(int generations) {
+    EventEmitter& emitter = EventEmitter::Instance();
+    emitter.EmitEvent("optimization_start", 0);
+    
+    std::cout << "\033[1;33m🧬 PARETO OPTIMIZATION STARTED (NSGA-II, " << generations
+              << " generations, " << populationSize << " individuals, "
+              << objectiveSpec.size() << " objectives)\033[0m" << std::endl;
+    
+    const std::vector<double>& lower = EnhancedSnakeOptimizer::getLowerBounds();
+    const std::vector<double>& upper = EnhancedSnakeOptimizer::getUpperBounds();
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    
+    // The defaults seed the population alongside uniform samples
+    evaluations = 0;
+    population.assign(populationSize, Solution{std::vector<double>(lower.size()), {}, 0, 0.0});
+    population[0].params = EnhancedSnakeOptimizer::getDefaultParams();
+    for (size_t i = 1; i < population.size(); i++) {
+        for (size_t d = 0; d < lower.size(); d++) {
+            population[i].params[d] = lower[d] + (upper[d] - lower[d]) * unit(rng);
+        }
+    }
+    evaluate(population);
+    rankAndCrowd(population);
+    
+    int progressStep = std::max(1, generations / 10);
+    for (int gen = 0; gen < generations; gen++) {
+        std::vector<Solution> offspring;
+        offspring.reserve(populationSize);
+        while (offspring.size() < populationSize) {
+            Solution a = tournament(population);
+            Solution b = tournament(population);
+            std::vector<double> childA, childB;
+            breed(a, b, childA, childB);
+            mutate(childA);
+            mutate(childB);
+            offspring.push_back(Solution{childA, {}, 0, 0.0});
+            offspring.push_back(Solution{childB, {}, 0, 0.0});
+        }
+        evaluate(offspring);
+        
+        // Environmental selection over parents + offspring
+        std::vector<Solution> combined(population);
+        combined.insert(combined.end(), offspring.begin(), offspring.end());
+        rankAndCrowd(combined);
+        std::sort(combined.begin(), combined.end(), [](const Solution& a, const Solution& b) {
+            if (a.rank != b.rank) return a.rank < b.rank;
+            return a.crowding > b.crowding;
+        });
+        combined.resize(populationSize);
+        population.swap(combined);
+        
+        // Crowding is relative to the front a solution sits in; recompute
+        // now that the last front may have been cut
+        rankAndCrowd(population);
+        
+        if (gen % progressStep == 0 || gen == generations - 1) {
+            size_t firstFront = std::count_if(population.begin(), population.end(),
+                                              [](const Solution& s) { return s.rank == 0; });
+            emitter.EmitEvent("optimization_progress", gen, -1, generations);
+            std::cout << "\033[33m  Generation " << gen << "/" << generations
+                      << " | Front: " << firstFront << " solutions\033[0m" << std::endl;
+        }
+    }
+    
+    extractFront();
+    emitter.EmitEvent("optimization_complete", generations);
+    std::cout << "\033[1;32m✓ PARETO OPTIMIZATION COMPLETE (" << evaluations << " evaluations, "
+              << front.size() << " front points)\033[0m" << std::endl;
+    return front;
+}
+
+std::string ParetoOptimizer::criteria() const {
+    std::string names = "balanced";
+    for (const Objective& objective : objectiveSpec) {
+        names += ", " + objective.name;
+    }
+    return names;
+}
+
+bool ParetoOptimizer::pick(const std::string& criterion, Solution& solution) const {
+    if (front.empty()) return false;
+    
+    for (size_t k = 0; k < objectiveSpec.size(); k++) {
+        if (objectiveSpec[k].name != criterion) continue;
+        solution = *std::min_element(front.begin(), front.end(), [&](const Solution& a, const Solution& b) {
+            return cost(a, k) < cost(b, k);
+        });
+        return true;
+    }
+    if (criterion != "balanced") return false;
+    
+    std::vector<double> low(objectiveSpec.size(), std::numeric_limits<double>::max());
+    std::vector<double> high(objectiveSpec.size(), std::numeric_limits<double>::lowest());
+    for (const Solution& s : front) {
+        for (size_t k = 0; k < objectiveSpec.size(); k++) {
+            low[k] = std::min(low[k], cost(s, k));
+            high[k] = std::max(high[k], cost(s, k));
+        }
+    }
+    
+    double bestDistance = std::numeric_limits<double>::max();
+    for (const Solution& s : front) {
+        double distance = 0.0;
+        for (size_t k = 0; k < objectiveSpec.size(); k++) {
+            double span = high[k] - low[k];
+            double normalized = (span > 0.0) ? (cost(s, k) - low[k]) / span : 0.0;
+            distance += normalized * normalized;
+        }
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            solution = s;
+        }
+    }
+    return true;
+}
+
+bool ParetoOptimizer::exportFront(const std::string& filename) const {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Failed to open file for Pareto front export: " << filename << std::endl;
+        return false;
+    }
+    
+    out << "# Pareto front (NSGA-II), one operating point per row\n";
+    out << "# energy_weight,power_control,sleep_ratio";
+    for (const Objective& objective : objectiveSpec) {
+        out << "," << objective.name;
+    }
+    out << "\n";
+    
+    out << std::setprecision(8);
+    for (const Solution& s : front) {
+        for (size_t d = 0; d < s.params.size(); d++) {
+            out << (d ? "," : "") << s.params[d];
+        }
+        for (double value : s.objectives) {
+            out << "," << value;
+        }
+        out << "\n";
+    }
+    
+    std::cout << "Pareto front exported to: " << filename << std::endl;
+    return true;
+}
+
+void ParetoOptimizer::printFront() const {
+    std::cout << "\n\033[1;32m✨ PARETO FRONT (" << front.size() << " points):\033[0m" << std::endl;
+    std::cout << "  EW     PC     SR    ";
+    for (const Objective& objective : objectiveSpec) {
+        std::cout << " " << std::setw(14) << objective.name;
+    }
+    std::cout << std::endl;
+    
+    for (const Solution& s : front) {
+        std::cout << "  " << std::fixed << std::setprecision(3);
+        for (size_t d = 0; d < 3 && d < s.params.size(); d++) {
+            std::cout << s.params[d] << "  ";
+        }
+        for (double value : s.objectives) {
+            std::cout << " " << std::setw(14) << std::setprecision(6) << value;
+        }
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,28 @@
+#include "rng_stream.h"
+
+namespace {
+const uint64_t kMultiplier = 0xD2B74407B1CE6E93ULL;
+const uint64_t kWeyl = 0x9E3779B97F4A7C15ULL;   // golden ratio key bump
+const int kRounds = 10;
+}
+
+RngStream::RngStream(uint64_t streamKey, uint64_t streamId, uint64_t startPosition)
+    : key(streamKey), stream(streamId), position(startPosition), cachedBlock(UINT64_MAX), output{0, 0} {}
+
+void RngStream::Block(uint64_t c0, uint64_t c1, uint64_t k, uint64_t out[2]) {
+    for (int round = 0; round < kRounds; round++) {
+        unsigned __int128 product = (unsigned __int128)kMultiplier * c0;
+        uint64_t hi = (uint64_t)(product >> 64);
+        uint64_t lo = (uint64_t)product;
+        c0 = hi ^ k ^ c1;
+        c1 = lo;
+        k += kWeyl;
+    }
+    out[0] = c0;
+    out[1] = c1;
+}
+
+void RngStream::Generate(uint64_t block) {
+    Block(block, stream, key, output);
+    cachedBlock = block;
+}
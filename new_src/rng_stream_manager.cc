@@ -0,0 +1,25 @@
+#include "rng_stream_manager.h"
+#include "fitness_cache.h"
+
+uint64_t RngStreamManager::GetKey() const {
+    // The first word of a Philox block over (seed, run): every setting
+    // gets an unrelated key
+    uint64_t out[2];
+    RngStream::Block(ns3::RngSeedManager::GetSeed(), ns3::RngSeedManager::GetRun(), 0, out);
+    return out[0];
+}
+
+uint64_t RngStreamManager::StreamId(const std::string& name, uint64_t index) {
+    uint64_t h = FitnessCache::Hash(name.data(), name.size());
+    return FitnessCache::Hash(&index, sizeof(index), h);
+}
+
+RngStream RngStreamManager::GetStream(const std::string& name, uint64_t index) const {
+    return RngStream(GetKey(), StreamId(name, index));
+}
+
+void RngStreamManager::AssignStream(ns3::Ptr<ns3::RandomVariableStream> variable, const std::string& name,
+                                    uint64_t index) const {
+    // Fixed streams are [0, 2^63); ns-3 allocates automatic ones above that
+    variable->SetStream((int64_t)(StreamId(name, index) >> 2));
+}
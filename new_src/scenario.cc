@@ -0,0 +1,88 @@
+#include "scenario.h"
+#include "fitness_cache.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/olsr-helper.h"
+#include "ns3/ipv4-list-routing-helper.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include <cmath>
+
+using namespace ns3;
+
+uint32_t Scenario::GetGridSize() const {
+    return (uint32_t)std::ceil(std::sqrt(nNodes));
+}
+
+double Scenario::GetLinkBudgetRange() const {
+    return std::pow(10.0, (txPowerDbm - rxSensitivityDbm - referenceLoss) /
+                          (10.0 * pathLossExponent));
+}
+
+uint64_t Scenario::Hash() const {
+    const double numbers[] = {
+        (double)nNodes, area, simulationTime, (double)sinkNode, gridOrigin, gridSpacing,
+        initialEnergy, deathThreshold, radio.supplyVoltage, radio.txCurrent, radio.rxCurrent,
+        radio.idleCurrent, radio.ccaBusyCurrent, radio.switchingCurrent, radio.sleepCurrent,
+        pathLossExponent, referenceLoss, txPowerDbm, rxSensitivityDbm, (double)powerControl,
+        txPowerMin, txPowerUpdate, dutyPeriod, (double)wakeMode, clusterFraction, clusterRound,
+        readingInterval, aggWindow, (double)aggregation, (double)aggCap, (double)txRedundancy
+    };
+    uint64_t h = FitnessCache::Hash(numbers, sizeof(numbers));
+    return FitnessCache::Hash(radio.name.data(), radio.name.size(), h);
+}
+
+void Scenario::InstallMobility(NodeContainer& nodes) const {
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                 "MinX", DoubleValue(gridOrigin),
+                                 "MinY", DoubleValue(gridOrigin),
+                                 "DeltaX", DoubleValue(gridSpacing),
+                                 "DeltaY", DoubleValue(gridSpacing),
+                                 "GridWidth", UintegerValue(GetGridSize()),
+                                 "LayoutType", StringValue("RowFirst"));
+    mobility.Install(nodes);
+}
+
+NetDeviceContainer Scenario::InstallRadios(NodeContainer& nodes) const {
+    YansWifiChannelHelper channel;
+    channel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+    channel.AddPropagationLoss("ns3::LogDistancePropagationLossModel",
+        "Exponent", DoubleValue(pathLossExponent),
+        "ReferenceDistance", DoubleValue(1.0),
+        "ReferenceLoss", DoubleValue(referenceLoss));
+    
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+    phy.Set("TxPowerStart", DoubleValue(txPowerDbm));
+    phy.Set("TxPowerEnd", DoubleValue(txPowerDbm));
+    phy.Set("RxSensitivity", DoubleValue(rxSensitivityDbm));
+    
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211b);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode", StringValue("DsssRate2Mbps"),
+                                 "ControlMode", StringValue("DsssRate1Mbps"));
+    
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    return wifi.Install(phy, mac, nodes);
+}
+
+Ipv4InterfaceContainer Scenario::InstallInternet(NodeContainer& nodes, NetDeviceContainer& devices) const {
+    OlsrHelper olsr;
+    olsr.Set("HelloInterval", TimeValue(Seconds(2.0)));
+    
+    Ipv4StaticRoutingHelper staticRouting;
+    Ipv4ListRoutingHelper list;
+    list.Add(staticRouting, 0);
+    list.Add(olsr, 10);
+    
+    InternetStackHelper internet;
+    internet.SetRoutingHelper(list);
+    internet.Install(nodes);
+    
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    return ipv4.Assign(devices);
+}
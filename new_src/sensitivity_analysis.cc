@@ -0,0 +1,371 @@
+#include "sensitivity_analysis.h"
+#include "sobol_sequence.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+namespace {
+// Morris grid: 4 levels and a jump of p / (2 (p - 1)) of the range, so
+// every base level below 1 - delta has a partner delta above it
+const uint32_t kMorrisLevels = 4;
+const double kMorrisDelta = kMorrisLevels / (2.0 * (kMorrisLevels - 1));
+
+// Below these a parameter is reported as negligible: total index, or mu*
+// relative to the largest mu* for that output
+const double kNegligibleTotal = 0.05;
+const double kNegligibleMuStar = 0.1;
+
+const uint32_t kMinUsableSamples = 4;
+
+bool AllFinite(const std::vector<double>& values) {
+    for (double value : values) {
+        if (!std::isfinite(value)) return false;
+    }
+    return true;
+}
+
+double StdDev(const std::vector<double>& values) {
+    if (values.size() < 2) return 0.0;
+    double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    double sum = 0.0;
+    for (double value : values) {
+        sum += (value - mean) * (value - mean);
+    }
+    return std::sqrt(sum / (values.size() - 1));
+}
+}
+
+SensitivityAnalysis::SensitivityAnalysis(const std::vector<Parameter>& parameters,
+                                         const std::vector<std::string>& outputs, ModelFunction function)
+    : parameterSpec(parameters), outputNames(outputs), model(function), batchSize(0),
+      bootstrapResamples(200), rng(0, 0), method(Method::Sobol), requestedSamples(0),
+      usableSamples(0), evaluations(0) {}
+
+bool SensitivityAnalysis::parseMethod(const std::string& name, Method& result) {
+    if (name == "sobol") {
+        result = Method::Sobol;
+    } else if (name == "morris") {
+        result = Method::Morris;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::vector<double> SensitivityAnalysis::scale(const std::vector<double>& unit) const {
+    std::vector<double> params(parameterSpec.size());
+    for (size_t d = 0; d < params.size(); d++) {
+        params[d] = parameterSpec[d].lower + (parameterSpec[d].upper - parameterSpec[d].lower) * unit[d];
+    }
+    return params;
+}
+
+void SensitivityAnalysis::evaluate(const std::vector<std::vector<double>>& candidates,
+                                   std::vector<std::vector<double>>& values) {
+    values.assign(candidates.size(), std::vector<double>());
+    size_t step = batchSize > 0 ? batchSize : candidates.size();
+    size_t batches = (candidates.size() + step - 1) / step;
+    
+    std::vector<std::vector<double>> batch;
+    std::vector<std::vector<double>> batchValues;
+    for (size_t b = 0; b < batches; b++) {
+        size_t first = b * step;
+        size_t count = std::min(step, candidates.size() - first);
+        batch.assign(candidates.begin() + first, candidates.begin() + first + count);
+        model(batch, batchValues);
+        for (size_t i = 0; i < count && i < batchValues.size(); i++) {
+            values[first + i] = batchValues[i];
+        }
+        evaluations += count;
+        
+        std::cout << "\033[33m  Batch " << b + 1 << "/" << batches << " | " << first + count << "/"
+                  << candidates.size() << " runs\033[0m" << std::endl;
+    }
+    
+    // A missing or short result counts as a failed run
+    for (std::vector<double>& row : values) {
+        if (row.size() != outputNames.size()) {
+            row.assign(outputNames.size(), std::nan(""));
+        }
+    }
+}
+
+bool SensitivityAnalysis::run(Method analysisMethod, uint32_t samples) {
+    method = analysisMethod;
+    requestedSamples = std::max(1u, samples);
+    usableSamples = 0;
+    evaluations = 0;
+    indices.assign(outputNames.size(), std::vector<Index>(parameterSpec.size(), Index{}));
+    
+    size_t k = parameterSpec.size();
+    uint64_t runs = (uint64_t)requestedSamples * (method == Method::Sobol ? k + 2 : k + 1);
+    std::cout << "\033[1;33m🔬 SENSITIVITY ANALYSIS STARTED (" << (method == Method::Sobol ? "Sobol" : "Morris")
+              << ", " << k << " parameters, " << requestedSamples
+              << (method == Method::Sobol ? " base points, " : " trajectories, ") << runs << " runs)\033[0m"
+              << std::endl;
+    
+    bool ok = method == Method::Sobol ? runSobol(requestedSamples) : runMorris(requestedSamples);
+    if (ok) {
+        std::cout << "\033[1;32m✓ SENSITIVITY ANALYSIS COMPLETE (" << evaluations << " runs)\033[0m" << std::endl;
+    }
+    return ok;
+}
+
+bool SensitivityAnalysis::runSobol(uint32_t samples) {
+    size_t k = parameterSpec.size();
+    if (2 * k > SobolSequence::kMaxDimensions) {
+        std::cerr << "Sensitivity analysis: Sobol sampling supports at most "
+                  << SobolSequence::kMaxDimensions / 2 << " parameters" << std::endl;
+        return false;
+    }
+    
+    // Candidate layout: A, B, then AB_0 .. AB_{k-1}, each `samples` rows
+    SobolSequence sequence((uint32_t)(2 * k));
+    std::vector<std::vector<double>> candidates(samples * (k + 2));
+    std::vector<double> point;
+    for (uint32_t j = 0; j < samples; j++) {
+        sequence.Next(point);
+        std::vector<double> a(point.begin(), point.begin() + k);
+        std::vector<double> b(point.begin() + k, point.end());
+        candidates[j] = scale(a);
+        candidates[samples + j] = scale(b);
+        for (size_t i = 0; i < k; i++) {
+            std::vector<double> ab = a;
+            ab[i] = b[i];
+            candidates[(2 + i) * samples + j] = scale(ab);
+        }
+    }
+    
+    std::vector<std::vector<double>> values;
+    evaluate(candidates, values);
+    
+    // Base points with every run of their block measured
+    std::vector<size_t> rows;
+    for (uint32_t j = 0; j < samples; j++) {
+        bool usable = true;
+        for (size_t block = 0; block < k + 2 && usable; block++) {
+            usable = AllFinite(values[block * samples + j]);
+        }
+        if (usable) rows.push_back(j);
+    }
+    usableSamples = (uint32_t)rows.size();
+    if (usableSamples < kMinUsableSamples) {
+        std::cerr << "Sensitivity analysis: only " << usableSamples << " of " << samples
+                  << " base points ran successfully" << std::endl;
+        return false;
+    }
+    
+    auto f = [&](size_t block, size_t j, size_t output) { return values[block * samples + j][output]; };
+    auto estimate = [&](const std::vector<size_t>& sample, size_t output, size_t i, double& first, double& total) {
+        double mean = 0.0;
+        for (size_t j : sample) {
+            mean += f(0, j, output) + f(1, j, output);
+        }
+        mean /= 2.0 * sample.size();
+        double variance = 0.0;
+        for (size_t j : sample) {
+            variance += (f(0, j, output) - mean) * (f(0, j, output) - mean)
+                      + (f(1, j, output) - mean) * (f(1, j, output) - mean);
+        }
+        variance /= 2.0 * sample.size();
+        
+        // An output that does not move has no variance to apportion
+        if (variance <= 1e-12 * mean * mean) {
+            first = total = 0.0;
+            return;
+        }
+        double firstSum = 0.0;
+        double totalSum = 0.0;
+        for (size_t j : sample) {
+            double fa = f(0, j, output);
+            double fb = f(1, j, output);
+            double fab = f(2 + i, j, output);
+            firstSum += fb * (fab - fa);
+            totalSum += (fa - fab) * (fa - fab);
+        }
+        first = firstSum / sample.size() / variance;
+        total = totalSum / (2.0 * sample.size()) / variance;
+    };
+    
+    std::vector<size_t> resample(rows.size());
+    std::uniform_int_distribution<size_t> pick(0, rows.size() - 1);
+    std::vector<double> firsts(bootstrapResamples);
+    std::vector<double> totals(bootstrapResamples);
+    for (size_t o = 0; o < outputNames.size(); o++) {
+        for (size_t i = 0; i < k; i++) {
+            Index& index = indices[o][i];
+            estimate(rows, o, i, index.first, index.total);
+            
+            for (uint32_t r = 0; r < bootstrapResamples; r++) {
+                for (size_t& j : resample) {
+                    j = rows[pick(rng)];
+                }
+                estimate(resample, o, i, firsts[r], totals[r]);
+            }
+            index.firstCi = 1.96 * StdDev(firsts);
+            index.totalCi = 1.96 * StdDev(totals);
+        }
+    }
+    return true;
+}
+
+bool SensitivityAnalysis::runMorris(uint32_t trajectories) {
+    size_t k = parameterSpec.size();
+    if (k > SobolSequence::kMaxDimensions) {
+        std::cerr << "Sensitivity analysis: Morris sampling supports at most "
+                  << SobolSequence::kMaxDimensions << " parameters" << std::endl;
+        return false;
+    }
+    
+    // Each trajectory starts on a quasi-random grid point and moves every
+    // parameter once by +-delta, in random order. step s moves moved[t][s].
+    SobolSequence sequence((uint32_t)k);
+    uint32_t baseLevels = kMorrisLevels / 2;
+    std::vector<std::vector<double>> candidates;
+    std::vector<std::vector<size_t>> moved(trajectories, std::vector<size_t>(k));
+    std::vector<std::vector<double>> deltas(trajectories, std::vector<double>(k));
+    std::vector<double> point;
+    for (uint32_t t = 0; t < trajectories; t++) {
+        sequence.Next(point);
+        std::vector<double> x(k);
+        for (size_t d = 0; d < k; d++) {
+            uint32_t level = std::min(baseLevels - 1, (uint32_t)(point[d] * baseLevels));
+            double sign = (rng() & 1) ? 1.0 : -1.0;
+            x[d] = (double)level / (kMorrisLevels - 1) + (sign < 0 ? kMorrisDelta : 0.0);
+            deltas[t][d] = sign * kMorrisDelta;
+        }
+        std::iota(moved[t].begin(), moved[t].end(), 0);
+        std::shuffle(moved[t].begin(), moved[t].end(), rng);
+        
+        candidates.push_back(scale(x));
+        for (size_t s = 0; s < k; s++) {
+            size_t d = moved[t][s];
+            x[d] += deltas[t][d];
+            candidates.push_back(scale(x));
+        }
+    }
+    
+    std::vector<std::vector<double>> values;
+    evaluate(candidates, values);
+    
+    // Elementary effects per unit of each parameter's range
+    std::vector<std::vector<std::vector<double>>> effects(outputNames.size(),
+                                                          std::vector<std::vector<double>>(k));
+    for (uint32_t t = 0; t < trajectories; t++) {
+        size_t base = t * (k + 1);
+        bool complete = true;
+        for (size_t s = 0; s < k; s++) {
+            const std::vector<double>& before = values[base + s];
+            const std::vector<double>& after = values[base + s + 1];
+            if (!AllFinite(before) || !AllFinite(after)) {
+                complete = false;
+                continue;
+            }
+            size_t d = moved[t][s];
+            for (size_t o = 0; o < outputNames.size(); o++) {
+                effects[o][d].push_back((after[o] - before[o]) / deltas[t][d]);
+            }
+        }
+        if (complete) usableSamples++;
+    }
+    
+    bool any = false;
+    for (size_t o = 0; o < outputNames.size(); o++) {
+        for (size_t d = 0; d < k; d++) {
+            const std::vector<double>& ee = effects[o][d];
+            if (ee.empty()) continue;
+            any = true;
+            Index& index = indices[o][d];
+            for (double e : ee) {
+                index.mu += e;
+                index.muStar += std::fabs(e);
+            }
+            index.mu /= ee.size();
+            index.muStar /= ee.size();
+            index.sigma = StdDev(ee);
+        }
+    }
+    if (!any) {
+        std::cerr << "Sensitivity analysis: no trajectory step ran successfully" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void SensitivityAnalysis::printReport() const {
+    if (indices.empty()) return;
+    
+    bool sobol = method == Method::Sobol;
+    std::cout << "\n\033[1;32m✨ SENSITIVITY ANALYSIS (" << (sobol ? "Sobol" : "Morris") << ", "
+              << usableSamples << "/" << requestedSamples << (sobol ? " base points" : " trajectories")
+              << " usable, " << evaluations << " runs):\033[0m" << std::endl;
+    
+    std::vector<bool> negligible(parameterSpec.size(), true);
+    for (size_t o = 0; o < outputNames.size(); o++) {
+        double maxMuStar = 0.0;
+        for (const Index& index : indices[o]) {
+            maxMuStar = std::max(maxMuStar, index.muStar);
+        }
+        
+        std::cout << "├─ " << outputNames[o] << (sobol ? "   (S1 first order, ST total, ±95%)" : "   (mu*, sigma)")
+                  << std::endl;
+        for (size_t d = 0; d < parameterSpec.size(); d++) {
+            const Index& index = indices[o][d];
+            std::cout << "│    " << std::left << std::setw(18) << parameterSpec[d].name << std::right;
+            if (sobol) {
+                std::cout << std::fixed << std::setprecision(3) << "S1 " << std::setw(6) << index.first
+                          << " ±" << std::setw(5) << index.firstCi << "   ST " << std::setw(6) << index.total
+                          << " ±" << std::setw(5) << index.totalCi;
+                negligible[d] = negligible[d] && index.total < kNegligibleTotal;
+            } else {
+                std::cout << std::scientific << std::setprecision(3) << "mu* " << std::setw(10) << index.muStar
+                          << "   sigma " << std::setw(10) << index.sigma;
+                negligible[d] = negligible[d] && index.muStar < kNegligibleMuStar * maxMuStar;
+            }
+            std::cout << std::endl;
+        }
+    }
+    std::cout << std::fixed;
+    
+    std::string names;
+    for (size_t d = 0; d < parameterSpec.size(); d++) {
+        if (negligible[d]) {
+            names += (names.empty() ? "" : ", ") + parameterSpec[d].name;
+        }
+    }
+    std::cout << "└─ Negligible for every output: " << (names.empty() ? "none" : names) << std::endl;
+}
+
+bool SensitivityAnalysis::exportCsv(const std::string& filename) const {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "Failed to open file for sensitivity export: " << filename << std::endl;
+        return false;
+    }
+    
+    bool sobol = method == Method::Sobol;
+    out << "# " << (sobol ? "Sobol" : "Morris") << " sensitivity, " << usableSamples << "/" << requestedSamples
+        << (sobol ? " base points" : " trajectories") << " usable, " << evaluations << " runs\n";
+    out << (sobol ? "# output,parameter,first_order,first_order_ci95,total,total_ci95\n"
+                  : "# output,parameter,mu_star,mu,sigma\n");
+    
+    out << std::setprecision(8);
+    for (size_t o = 0; o < indices.size(); o++) {
+        for (size_t d = 0; d < parameterSpec.size(); d++) {
+            const Index& index = indices[o][d];
+            out << outputNames[o] << "," << parameterSpec[d].name << ",";
+            if (sobol) {
+                out << index.first << "," << index.firstCi << "," << index.total << "," << index.totalCi << "\n";
+            } else {
+                out << index.muStar << "," << index.mu << "," << index.sigma << "\n";
+            }
+        }
+    }
+    
+    std::cout << "Sensitivity indices exported to: " << filename << std::endl;
+    return true;
+}
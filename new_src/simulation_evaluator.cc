@@ -0,0 +1,423 @@
+#include "simulation_evaluator.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "memostp_protocol.h"
+#include "node_monitor.h"
+#include "death_tracker.h"
+#include "cluster_manager.h"
+#include "cluster_app.h"
+#include "tx_power_controller.h"
+#include "duty_cycle_scheduler.h"
+#include "energy_model_helper.h"
+#include "fitness_cache.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace ns3;
+
+namespace {
+
+const uint32_t kMaxParams = 8;
+const double kLifetimeWeight = 0.4;
+const double kDeliveryWeight = 0.4;
+const double kEnergyWeight = 0.2;
+
+// Bump when the sub-simulation or Score() changes so cached fitness from
+// older builds is not reused
+const uint32_t kScoreVersion = 3;
+
+const double kReadingBits = 128.0;
+
+struct Request {
+    uint32_t index;
+    uint32_t dimensions;
+    double params[kMaxParams];
+};
+
+struct Response {
+    uint32_t index;
+    uint32_t reserved;
+    SimulationOutcome outcome;
+};
+
+bool WriteFull(int fd, const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+bool ReadFull(int fd, void* data, size_t size) {
+    uint8_t* p = static_cast<uint8_t*>(data);
+    while (size > 0) {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+} // namespace
+
+SimulationFitnessEvaluator::SimulationFitnessEvaluator(const Scenario& scenario, double duration)
+    : m_scenario(scenario), m_duration(std::max(1.0, duration)), m_simulations(0) {}
+
+SimulationFitnessEvaluator::~SimulationFitnessEvaluator() {
+    Stop();
+}
+
+bool SimulationFitnessEvaluator::Start(uint32_t workers) {
+    if (IsRunning()) return true;
+    if (workers == 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    // A worker that dies mid-write must not take this process down
+    signal(SIGPIPE, SIG_IGN);
+    std::cout.flush();
+    
+    for (uint32_t w = 0; w < workers; w++) {
+        int request[2];
+        int response[2];
+        if (pipe(request) != 0) break;
+        if (pipe(response) != 0) {
+            close(request[0]);
+            close(request[1]);
+            break;
+        }
+        
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(request[0]);
+            close(request[1]);
+            close(response[0]);
+            close(response[1]);
+            break;
+        }
+        
+        if (pid == 0) {
+            // Earlier workers' pipe ends would otherwise keep them from
+            // seeing end-of-file when this process shuts the pool down
+            for (const Worker& other : m_workers) {
+                close(other.requestFd);
+                close(other.responseFd);
+            }
+            close(request[1]);
+            close(response[0]);
+            WorkerLoop(m_scenario, m_duration, request[0], response[1]);
+            _exit(0);
+        }
+        
+        close(request[0]);
+        close(response[1]);
+        m_workers.push_back(Worker{pid, request[1], response[0]});
+    }
+    
+    if (m_workers.empty()) {
+        std::cerr << "Simulation fitness: could not start worker processes" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void SimulationFitnessEvaluator::Stop() {
+    for (Worker& worker : m_workers) {
+        close(worker.requestFd);
+    }
+    for (Worker& worker : m_workers) {
+        waitpid(worker.pid, nullptr, 0);
+        close(worker.responseFd);
+    }
+    m_workers.clear();
+}
+
+void SimulationFitnessEvaluator::WorkerLoop(const Scenario& scenario, double duration,
+                                            int requestFd, int responseFd) {
+    // Sub-simulations print their component reports; keep them off the
+    // parent's console and JSON stream
+    int devNull = open("/dev/null", O_WRONLY);
+    if (devNull >= 0) {
+        dup2(devNull, STDOUT_FILENO);
+        close(devNull);
+    }
+    
+    Request request;
+    while (ReadFull(requestFd, &request, sizeof(request))) {
+        Response response{};
+        response.index = request.index;
+        
+        int result[2];
+        if (pipe(result) == 0) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                close(result[0]);
+                std::vector<double> params(request.params, request.params + request.dimensions);
+                SimulationOutcome outcome = RunSubSimulation(scenario, params, duration);
+                WriteFull(result[1], &outcome, sizeof(outcome));
+                _exit(0);
+            }
+            
+            close(result[1]);
+            if (pid > 0) {
+                // A short read means the run aborted; the outcome stays invalid
+                if (!ReadFull(result[0], &response.outcome, sizeof(response.outcome))) {
+                    response.outcome = SimulationOutcome{};
+                }
+                waitpid(pid, nullptr, 0);
+            }
+            close(result[0]);
+        }
+        
+        if (!WriteFull(responseFd, &response, sizeof(response))) break;
+    }
+    
+    close(requestFd);
+    close(responseFd);
+}
+
+void SimulationFitnessEvaluator::Simulate(const std::vector<std::vector<double>>& candidates,
+                                          std::vector<SimulationOutcome>& outcomes) {
+    outcomes.assign(candidates.size(), SimulationOutcome{});
+    if (!IsRunning() || candidates.empty()) return;
+    
+    size_t next = 0;
+    size_t done = 0;
+    std::vector<uint8_t> busy(m_workers.size(), 0);
+    
+    auto dispatch = [&](size_t w) {
+        if (next >= candidates.size()) return;
+        Request request{};
+        request.index = (uint32_t)next;
+        request.dimensions = (uint32_t)std::min<size_t>(kMaxParams, candidates[next].size());
+        std::copy(candidates[next].begin(), candidates[next].begin() + request.dimensions, request.params);
+        next++;
+        busy[w] = WriteFull(m_workers[w].requestFd, &request, sizeof(request));
+        if (!busy[w]) done++;
+    };
+    
+    for (size_t w = 0; w < m_workers.size(); w++) {
+        dispatch(w);
+    }
+    
+    std::vector<pollfd> fds(m_workers.size());
+    while (done < candidates.size()) {
+        size_t waiting = 0;
+        for (size_t w = 0; w < m_workers.size(); w++) {
+            fds[w].fd = busy[w] ? m_workers[w].responseFd : -1;
+            fds[w].events = POLLIN;
+            fds[w].revents = 0;
+            waiting += busy[w];
+        }
+        if (waiting == 0) break;
+        
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        
+        for (size_t w = 0; w < m_workers.size(); w++) {
+            if (!busy[w] || fds[w].revents == 0) continue;
+            
+            Response response;
+            busy[w] = 0;
+            done++;
+            if (ReadFull(m_workers[w].responseFd, &response, sizeof(response)) &&
+                response.index < outcomes.size()) {
+                outcomes[response.index] = response.outcome;
+                m_simulations++;
+                dispatch(w);
+            }
+        }
+    }
+}
+
+void SimulationFitnessEvaluator::Evaluate(const std::vector<std::vector<double>>& candidates,
+                                          std::vector<double>& fitness) {
+    std::vector<SimulationOutcome> outcomes;
+    Simulate(candidates, outcomes);
+    
+    fitness.resize(candidates.size());
+    for (size_t i = 0; i < candidates.size(); i++) {
+        fitness[i] = Score(outcomes[i]);
+    }
+}
+
+void SimulationFitnessEvaluator::EvaluateObjectives(const std::vector<std::vector<double>>& candidates,
+                                                    std::vector<std::vector<double>>& objectives,
+                                                    FitnessCache* cache) {
+    static const char kTag[] = "objectives";
+    uint64_t context = FitnessCache::Hash(kTag, sizeof(kTag), GetContextHash());
+    
+    objectives.assign(candidates.size(), std::vector<double>());
+    std::vector<std::vector<double>> misses;
+    std::vector<size_t> missIndex;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (!cache || !cache->Lookup(context, candidates[i], objectives[i])) {
+            misses.push_back(candidates[i]);
+            missIndex.push_back(i);
+        }
+    }
+    
+    std::vector<SimulationOutcome> outcomes;
+    Simulate(misses, outcomes);
+    for (size_t m = 0; m < misses.size(); m++) {
+        const SimulationOutcome& outcome = outcomes[m];
+        double bits = outcome.readingsDelivered * kReadingBits;
+        
+        // A failed run is dominated by every measured one
+        std::vector<double>& values = objectives[missIndex[m]];
+        if (outcome.valid) {
+            values = {outcome.lifetime, outcome.deliveryRatio, outcome.averageDelay,
+                      bits > 0 ? outcome.energyConsumed / bits : outcome.energyConsumed};
+            if (cache) {
+                cache->Insert(context, misses[m], values);
+            }
+        } else {
+            values = {0.0, 0.0, std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+        }
+    }
+}
+
+uint64_t SimulationFitnessEvaluator::GetContextHash() const {
+    uint64_t h = m_scenario.Hash();
+    h = FitnessCache::Hash(&m_duration, sizeof(m_duration), h);
+    return FitnessCache::Hash(&kScoreVersion, sizeof(kScoreVersion), h);
+}
+
+double SimulationFitnessEvaluator::Score(const SimulationOutcome& outcome) const {
+    if (!outcome.valid) return 0.0;
+    
+    double horizon = m_scenario.simulationTime;
+    double lifetimeScore = outcome.lifetime / (outcome.lifetime + horizon);
+    
+    double budget = m_scenario.nNodes * m_scenario.initialEnergy;
+    double projected = outcome.energyConsumed / m_duration * horizon;
+    double energyScore = (budget > 0) ? 1.0 - std::min(1.0, projected / budget) : 0.0;
+    
+    return kLifetimeWeight * lifetimeScore +
+           kDeliveryWeight * outcome.deliveryRatio +
+           kEnergyWeight * energyScore;
+}
+
+SimulationOutcome SimulationFitnessEvaluator::RunSubSimulation(const Scenario& scenario,
+                                                               const std::vector<double>& params,
+                                                               double duration) {
+    double energyWeight = params.size() > 0 ? params[0] : 0.6;
+    double powerControl = params.size() > 1 ? params[1] : 0.7;
+    double sleepRatio = params.size() > 2 ? params[2] : 0.3;
+    
+    // An optional fourth value is the resilience factor, rounded to the
+    // power controller's neighbour redundancy
+    uint32_t redundancy = params.size() > 3 ? (uint32_t)std::max(1L, std::lround(params[3]))
+                                            : scenario.txRedundancy;
+    
+    NodeContainer nodes;
+    nodes.Create(scenario.nNodes);
+    scenario.InstallMobility(nodes);
+    NetDeviceContainer devices = scenario.InstallRadios(nodes);
+    
+    EnergyModelHelper energyModel(scenario.radio);
+    energyModel.InstallEnergyModel(nodes, devices, scenario.initialEnergy, scenario.deathThreshold);
+    
+    Ipv4InterfaceContainer interfaces = scenario.InstallInternet(nodes, devices);
+    
+    NodeMonitor monitor;
+    monitor.InitializeNodes(scenario.nNodes, scenario.initialEnergy);
+    std::vector<Ipv4Address> addresses;
+    for (uint32_t i = 0; i < scenario.nNodes; ++i) {
+        Vector position = nodes.Get(i)->GetObject<MobilityModel>()->GetPosition();
+        monitor.UpdatePosition(i, position.x, position.y);
+        addresses.push_back(interfaces.GetAddress(i));
+    }
+    
+    // Readings travel in the clear: the radio energy model charges airtime,
+    // not cipher work, and the tag is a few bytes per frame
+    EnhancedMEMOSTPProtocol protocol(nodes, 0);
+    protocol.setCryptoEnabled(false);
+    
+    TxPowerController txPower;
+    if (scenario.powerControl) {
+        txPower.Configure(devices, scenario.txPowerMin, scenario.txPowerDbm,
+                          scenario.rxSensitivityDbm, powerControl, redundancy);
+        txPower.Start(std::min(5.0, duration / 4), scenario.txPowerUpdate);
+    }
+    
+    // Same death detection as the main simulation, so the cluster election
+    // sees current residual energy and never picks a dead head
+    Ptr<DeathTracker> deathTracker = CreateObject<DeathTracker>(nodes, monitor, energyModel);
+    deathTracker->Start();
+    if (scenario.powerControl) {
+        deathTracker->SetDeathCallback(MakeCallback(&TxPowerController::NodeDied, &txPower));
+    }
+    
+    DutyCycleScheduler dutyCycle;
+    if (scenario.dutyPeriod > 0.0) {
+        dutyCycle.Configure(devices, scenario.dutyPeriod, sleepRatio, scenario.wakeMode);
+        dutyCycle.Start(1.0);
+    }
+    
+    ClusterManager clusters;
+    clusters.Configure(monitor, scenario.sinkNode, scenario.clusterFraction, energyWeight,
+                       std::min(scenario.clusterRound, duration / 3));
+    clusters.Start(2.0);
+    
+    for (uint32_t i = 0; i < scenario.nNodes; ++i) {
+        Ptr<ClusterTrafficApplication> app = CreateObject<ClusterTrafficApplication>();
+        app->Setup(&clusters, &protocol, i, addresses, 9998, scenario.readingInterval,
+                   scenario.aggWindow, scenario.aggregation, scenario.aggCap);
+        if (dutyCycle.IsEnabled()) {
+            app->SetDutyCycle(&dutyCycle);
+        }
+        nodes.Get(i)->AddApplication(app);
+        app->SetStartTime(Seconds(2.0));
+        app->SetStopTime(Seconds(duration));
+    }
+    
+    Simulator::Stop(Seconds(duration));
+    Simulator::Run();
+    
+    SimulationOutcome outcome{};
+    outcome.valid = 1;
+    outcome.lifetime = std::numeric_limits<double>::max();
+    for (uint32_t i = 0; i < scenario.nNodes; ++i) {
+        double remaining = EnergyModelHelper::GetRemainingEnergy(nodes, i);
+        double consumed = scenario.initialEnergy - remaining;
+        outcome.energyConsumed += consumed;
+        
+        // First death: the recorded time for nodes that died, otherwise
+        // extrapolated at the node's average drain
+        if (!monitor.IsNodeAlive(i)) {
+            outcome.lifetime = std::min(outcome.lifetime, monitor.DeathTimeColumn()[i]);
+        } else if (consumed > 0.0) {
+            double rate = consumed / duration;
+            double lifetime = (scenario.initialEnergy - scenario.deathThreshold) / rate;
+            outcome.lifetime = std::min(outcome.lifetime, lifetime);
+        }
+    }
+    outcome.deliveryRatio = clusters.GetDeliveryRatio() / 100.0;
+    outcome.averageDelay = clusters.GetAverageLatency();
+    outcome.readingsDelivered = clusters.GetReadingsDelivered();
+    outcome.energyPerReading = (outcome.readingsDelivered > 0) ?
+        outcome.energyConsumed / outcome.readingsDelivered : outcome.energyConsumed;
+    
+    Simulator::Destroy();
+    return outcome;
+}
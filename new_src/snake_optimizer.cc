@@ -1,7 +1,78 @@
 #include "snake_optimizer.h"
+#include "thread_pool.h"
+#include "fitness_evaluator.h"
 #include "event_emitter.h"
+#include "parameter_matrix.h"
+#include <algorithm>
+#include <limits>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
 
-double EnhancedSnakeOptimizer::fitnessFunction(const std::vector<double>& params) {
+namespace {
+// Snake Optimizer constants from the paper
+constexpr double kC1 = 0.5;
+constexpr double kC2 = 0.05;
+constexpr double kC3 = 2.0;
+constexpr double kFoodThreshold = 0.25;
+constexpr double kHotThreshold = 0.6;
+constexpr double kModeThreshold = 0.6;
+constexpr double kEggThreshold = 0.6;
+
+// Step scale for a snake of fitness f against a reference of fitness ref.
+// The paper minimizes and uses exp(-ref / f); fitness is maximized here, so
+// the ratio is inverted: weaker snakes take larger steps.
+double StepScale(double f, double ref) {
+    return std::exp(-std::max(f, 1e-9) / std::max(ref, 1e-9));
+}
+
+// Checkpoint file: this header, then per snake its position and fitness,
+// each snake stream's position, the best parameters, and per history entry
+// its position and fitness. Doubles throughout, native byte order.
+const char kCheckpointMagic[8] = {'W', 'S', 'N', 'S', 'N', 'A', 'K', '1'};
+
+struct CheckpointHeader {
+    char magic[8];
+    uint64_t context;
+    uint32_t populationSize;
+    uint32_t dimensions;
+    int32_t runIterations;
+    int32_t iteration;            // generations finished
+    uint64_t evaluations;
+    uint64_t rngKey;
+    uint64_t rngStream;
+    uint64_t rngPosition;
+    uint64_t streamKey;           // snake i draws from (streamKey, i)
+    double bestFitness;
+    uint32_t bestMale;
+    uint32_t bestFemale;
+    uint32_t historyCount;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(CheckpointHeader) == 96, "CheckpointHeader layout changed");
+}
+
+// Energy weight, power control, sleep ratio
+const std::vector<double> EnhancedSnakeOptimizer::lowerBounds = {0.4, 0.4, 0.1};
+const std::vector<double> EnhancedSnakeOptimizer::upperBounds = {0.8, 0.9, 0.5};
+const std::vector<double> EnhancedSnakeOptimizer::defaultParams = {0.6, 0.7, 0.3};
+
+EnhancedSnakeOptimizer::EnhancedSnakeOptimizer()
+    : populationSize(30), threadCount(0), fitnessEvaluator(nullptr), layout(nullptr),
+      networkDrain(0.0), lower(lowerBounds), upper(upperBounds), rng(0, 0),
+      bestMale(0), bestFemale(0), bestParams(defaultParams), bestFitness(0.0), evaluations(0),
+      running(false), scoringPopulation(false), runIterations(0), iteration(0), scored(0),
+      hatching(false), checkpointContext(0), checkpointEvery(1), checkpointing(false) {}
+
+EnhancedSnakeOptimizer::~EnhancedSnakeOptimizer() = default;
+
+void EnhancedSnakeOptimizer::setPopulationSize(uint32_t size) {
+    size = std::max(4u, size);
+    populationSize = size + (size % 2);
+}
+
+double EnhancedSnakeOptimizer::fitnessFunction(const std::vector<double>& params) const {
     // Combined fitness: maximize energy efficiency and network lifetime
     if (params.size() < 3) return 0.0;
     
@@ -9,17 +80,21 @@ double EnhancedSnakeOptimizer::fitnessFunction(const std::vector<double>& params
     double powerControl = params[1];      // Should be high (0.6-0.8)
     double sleepRatio = params[2];        // Should be moderate (0.2-0.4)
     
+    // A drained network shifts every target towards saving energy, as the
+    // per-node kernel does
+    double save = ParameterMatrix::kDrainShift * networkDrain;
+    
     // Calculate fitness
     double fitness = 0.0;
     
     // Energy weight component (closer to 0.6 is better)
-    fitness += 1.0 - fabs(energyWeight - 0.6);
+    fitness += 1.0 - fabs(energyWeight - (0.6 + save));
     
     // Power control component (closer to 0.75 is better)
-    fitness += 1.0 - fabs(powerControl - 0.75);
+    fitness += 1.0 - fabs(powerControl - (0.75 + save));
     
     // Sleep ratio component (closer to 0.3 is better)
-    fitness += 1.0 - fabs(sleepRatio - 0.3);
+    fitness += 1.0 - fabs(sleepRatio - (0.3 + save));
     
     // Penalize extreme values
     if (energyWeight < 0.4 || energyWeight > 0.8) fitness *= 0.5;
@@ -29,70 +104,441 @@ double EnhancedSnakeOptimizer::fitnessFunction(const std::vector<double>& params
     return fitness;
 }
 
-void EnhancedSnakeOptimizer::updateSnakePosition(std::vector<double>& params, 
-                                                int iteration, int totalIterations) {
-    if (params.size() < 3) return;
+void EnhancedSnakeOptimizer::clampToBounds(std::vector<double>& position) const {
+    for (size_t d = 0; d < position.size(); d++) {
+        position[d] = std::max(lower[d], std::min(upper[d], position[d]));
+    }
+}
+
+void EnhancedSnakeOptimizer::evaluate(std::vector<Snake>& snakes, size_t first, size_t count) {
+    if (fitnessEvaluator) {
+        std::vector<std::vector<double>> candidates(count);
+        for (size_t i = 0; i < count; i++) {
+            candidates[i] = snakes[first + i].position;
+        }
+        std::vector<double> fitness;
+        fitnessEvaluator->Evaluate(candidates, fitness);
+        for (size_t i = 0; i < count; i++) {
+            snakes[first + i].fitness = fitness[i];
+        }
+    } else {
+        pool->ParallelFor(count, [&](size_t i) {
+            Snake& snake = snakes[first + i];
+            if (layout) {
+                thread_local std::vector<double> scratch;
+                snake.fitness = layout->Score(snake.position, scratch);
+            } else {
+                snake.fitness = fitnessFunction(snake.position);
+            }
+        });
+    }
+    evaluations += count;
+}
+
+void EnhancedSnakeOptimizer::setParameterLayout(const ParameterMatrix* matrix) {
+    layout = matrix;
+    uint32_t regions = layout ? layout->GetRegionCount() : 1;
+    lower.clear();
+    upper.clear();
+    for (uint32_t r = 0; r < regions; r++) {
+        lower.insert(lower.end(), lowerBounds.begin(), lowerBounds.end());
+        upper.insert(upper.end(), upperBounds.begin(), upperBounds.end());
+    }
+    
+    // Dimensions changed: the next run starts cold from the current best,
+    // repeated over the regions
+    population.clear();
+    setStartingPoint(std::vector<double>(bestParams.begin(), bestParams.begin() + lowerBounds.size()));
+}
+
+void EnhancedSnakeOptimizer::setStartingPoint(const std::vector<double>& params) {
+    // One triple applies to every region
+    bestParams.resize(lower.size());
+    for (size_t d = 0; d < lower.size(); d++) {
+        size_t k = d % lowerBounds.size();
+        bestParams[d] = d < params.size() ? params[d] : k < params.size() ? params[k] : defaultParams[k];
+    }
+    clampToBounds(bestParams);
+}
+
+void EnhancedSnakeOptimizer::initializePopulation() {
+    uint64_t streamKey = rng();
+    streams.clear();
+    for (uint32_t i = 0; i < populationSize; i++) {
+        streams.emplace_back(streamKey, i);
+    }
     
-    std::uniform_real_distribution<double> dist(-0.1, 0.1);
-    std::normal_distribution<double> normal(0.0, 0.05);
+    // The previous best (or the defaults) seeds the population so a short
+    // run never ends up worse than where it started
+    population.assign(populationSize, Snake{std::vector<double>(lower.size()), 0.0});
+    population[0].position = bestParams;
+    for (size_t i = 1; i < population.size(); i++) {
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        for (size_t d = 0; d < lower.size(); d++) {
+            population[i].position[d] = lower[d] + (upper[d] - lower[d]) * unit(streams[i]);
+        }
+    }
+    clampToBounds(population[0].position);
+    history.clear();
+}
+
+void EnhancedSnakeOptimizer::warmStart() {
+    std::vector<size_t> order(population.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return population[a].fitness < population[b].fitness;
+    });
     
-    double progress = (double)iteration / totalIterations;
-    double exploration = 0.3 * (1.0 - progress);
-    double exploitation = 0.7 * progress;
+    // Newest distinct history entries first; random snakes once it runs out
+    size_t next = history.size();
+    const std::vector<double>* previous = nullptr;
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (size_t k = 0; k < population.size() / 4; k++) {
+        Snake& snake = population[order[k]];
+        while (next > 0 && previous && history[next - 1].position == *previous) next--;
+        if (next > 0) {
+            snake.position = history[--next].position;
+            previous = &snake.position;
+        } else {
+            for (size_t d = 0; d < lower.size(); d++) {
+                snake.position[d] = lower[d] + (upper[d] - lower[d]) * unit(streams[order[k]]);
+            }
+        }
+    }
+}
+
+void EnhancedSnakeOptimizer::updateBest() {
+    size_t half = population.size() / 2;
+    bestMale = 0;
+    bestFemale = half;
+    for (size_t i = 0; i < half; i++) {
+        if (population[i].fitness > population[bestMale].fitness) bestMale = i;
+        if (population[half + i].fitness > population[bestFemale].fitness) bestFemale = half + i;
+    }
     
-    // Update each parameter with snake-like movement
-    for (size_t i = 0; i < params.size(); i++) {
-        double randomMove = dist(rng) * exploration;
-        double guidedMove = (bestParams[i] - params[i]) * exploitation;
-        double noise = normal(rng) * (1.0 - progress);
-        
-        params[i] += randomMove + guidedMove + noise;
-        
-        // Apply bounds
-        if (i == 0) params[i] = std::max(0.4, std::min(0.8, params[i])); // Energy weight
-        if (i == 1) params[i] = std::max(0.4, std::min(0.9, params[i])); // Power control
-        if (i == 2) params[i] = std::max(0.1, std::min(0.5, params[i])); // Sleep ratio
+    const Snake& food = population[bestMale].fitness >= population[bestFemale].fitness
+                        ? population[bestMale] : population[bestFemale];
+    if (food.fitness > bestFitness) {
+        bestFitness = food.fitness;
+        bestParams = food.position;
     }
 }
 
-std::vector<double> EnhancedSnakeOptimizer::optimize(int iterations) {
-    EventEmitter& emitter = EventEmitter::Instance();
-    emitter.EmitEvent("optimization_start", 0);
+void EnhancedSnakeOptimizer::moveSnake(size_t index, double temperature, double food,
+                                       bool fight, std::vector<double>& position) {
+    RngStream& stream = streams[index];
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto sign = [&]() { return unit(stream) < 0.5 ? -1.0 : 1.0; };
     
-    std::cout << "\033[1;33m🧬 SNAKE OPTIMIZATION STARTED (" << iterations << " iterations)\033[0m" << std::endl;
+    size_t half = population.size() / 2;
+    bool male = index < half;
+    size_t groupStart = male ? 0 : half;
+    const Snake& self = population[index];
+    position = self.position;
+    
+    if (food < kFoodThreshold) {
+        // Exploration: no food, search around a random member of the same sex
+        const Snake& mate = population[groupStart + std::uniform_int_distribution<size_t>(0, half - 1)(stream)];
+        double scale = StepScale(self.fitness, mate.fitness);
+        for (size_t d = 0; d < position.size(); d++) {
+            double span = (upper[d] - lower[d]) * unit(stream) + lower[d];
+            position[d] = mate.position[d] + sign() * kC2 * scale * span;
+        }
+    } else if (temperature > kHotThreshold) {
+        // Exploitation, hot: move towards the food
+        for (size_t d = 0; d < position.size(); d++) {
+            position[d] = bestParams[d] + sign() * kC3 * temperature * unit(stream) * (bestParams[d] - self.position[d]);
+        }
+    } else if (fight) {
+        // Exploitation, cold, fight: each sex moves towards the other's best
+        const Snake& rival = population[male ? bestFemale : bestMale];
+        double scale = StepScale(self.fitness, rival.fitness);
+        for (size_t d = 0; d < position.size(); d++) {
+            position[d] += kC3 * scale * unit(stream) * (food * rival.position[d] - self.position[d]);
+        }
+    } else {
+        // Exploitation, cold, mating: pair i of one half with pair i of the other
+        const Snake& partner = population[male ? index + half : index - half];
+        double scale = StepScale(self.fitness, partner.fitness);
+        for (size_t d = 0; d < position.size(); d++) {
+            position[d] += kC3 * scale * unit(stream) * (food * partner.position[d] - self.position[d]);
+        }
+    }
+    
+    clampToBounds(position);
+}
+
+void EnhancedSnakeOptimizer::preparePool() {
+    if (!pool || (threadCount != 0 && pool->GetThreadCount() != threadCount)) {
+        pool.reset(new ThreadPool(threadCount));
+    }
+}
+
+void EnhancedSnakeOptimizer::start(int iterations, bool warm) {
+    preparePool();
+    
+    if (warm && population.size() == populationSize) {
+        warmStart();
+    } else {
+        initializePopulation();
+    }
     
-    std::vector<double> currentParams = bestParams;
-    double bestFitness = fitnessFunction(bestParams);
+    runIterations = std::max(0, iterations);
+    iteration = 0;
+    evaluations = 0;
+    scored = 0;
+    scoringPopulation = true;
+    running = true;
+}
+
+bool EnhancedSnakeOptimizer::step(uint32_t budget) {
+    if (!running) return true;
     
-    for (int iter = 0; iter < iterations; iter++) {
-        // Generate new candidate
-        std::vector<double> candidate = currentParams;
-        updateSnakePosition(candidate, iter, iterations);
+    size_t remaining = budget > 0 ? budget : std::numeric_limits<size_t>::max();
+    while (true) {
+        std::vector<Snake>& batch = scoringPopulation ? population : offspring;
+        if (scored < batch.size()) {
+            if (remaining == 0) return false;
+            size_t count = std::min(remaining, batch.size() - scored);
+            evaluate(batch, scored, count);
+            scored += count;
+            remaining -= count;
+            continue;
+        }
         
-        double candidateFitness = fitnessFunction(candidate);
+        if (scoringPopulation) {
+            scoringPopulation = false;
+            bestFitness = -1.0;
+            updateBest();
+        } else {
+            finishGeneration();
+            iteration++;
+        }
         
-        // Acceptance criterion
-        if (candidateFitness > bestFitness || 
-            std::exp((candidateFitness - bestFitness) / (1.0 - (double)iter/iterations)) > 
-            std::uniform_real_distribution<double>(0, 1)(rng)) {
-            currentParams = candidate;
-            if (candidateFitness > bestFitness) {
-                bestParams = candidate;
-                bestFitness = candidateFitness;
-            }
+        if (checkpointing && (iteration % checkpointEvery == 0 || iteration >= runIterations)
+            && !saveCheckpoint()) {
+            std::cerr << "Optimizer checkpoint: cannot write " << checkpointPath
+                      << ", continuing without checkpoints" << std::endl;
+            checkpointing = false;
         }
         
-        // Emit progress
-        if (iter % (iterations/10) == 0 || iter == iterations-1) {
-            emitter.EmitEvent("optimization_progress", iter, -1, iterations);
-            std::cout << "\033[33m  Iteration " << iter << "/" << iterations 
-                      << " | Fitness: " << std::fixed << std::setprecision(4) 
-                      << bestFitness << "\033[0m" << std::endl;
+        if (iteration >= runIterations) {
+            running = false;
+            return true;
+        }
+        beginGeneration();
+    }
+}
+
+void EnhancedSnakeOptimizer::beginGeneration() {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double progress = (double)(iteration + 1) / runIterations;
+    double temperature = std::exp(-progress);
+    double food = kC1 * std::exp(progress - 1.0);
+    bool fight = unit(rng) > kModeThreshold;
+    bool mating = food >= kFoodThreshold && temperature <= kHotThreshold && !fight;
+    
+    // After mating, eggs may hatch and replace the weakest of each sex; they
+    // are scored in the same batch as the offspring
+    hatching = mating && unit(rng) > kEggThreshold;
+    offspring.resize(population.size() + (hatching ? 2 : 0));
+    
+    // Every snake moves from the previous generation in parallel
+    pool->ParallelFor(population.size(), [&](size_t i) {
+        moveSnake(i, temperature, food, fight, offspring[i].position);
+    });
+    for (size_t e = population.size(); e < offspring.size(); e++) {
+        offspring[e].position.resize(lower.size());
+        for (size_t d = 0; d < lower.size(); d++) {
+            offspring[e].position[d] = lower[d] + (upper[d] - lower[d]) * unit(rng);
+        }
+    }
+    scored = 0;
+}
+
+void EnhancedSnakeOptimizer::finishGeneration() {
+    // Offspring replace their parents greedily
+    for (size_t i = 0; i < population.size(); i++) {
+        if (offspring[i].fitness > population[i].fitness) {
+            population[i] = offspring[i];
         }
     }
     
+    if (hatching) {
+        size_t half = population.size() / 2;
+        auto weakest = [&](size_t start) {
+            size_t worst = start;
+            for (size_t i = start; i < start + half; i++) {
+                if (population[i].fitness < population[worst].fitness) worst = i;
+            }
+            return worst;
+        };
+        population[weakest(0)] = offspring[population.size()];
+        population[weakest(half)] = offspring[population.size() + 1];
+    }
+    
+    updateBest();
+    history.push_back(Snake{bestParams, bestFitness});
+    
+    // Emit progress
+    int progressStep = std::max(1, runIterations / 10);
+    if (iteration % progressStep == 0 || iteration == runIterations - 1) {
+        EventEmitter::Instance().EmitEvent("optimization_progress", iteration, -1, runIterations);
+        std::cout << "\033[33m  Iteration " << iteration << "/" << runIterations
+                  << " | Fitness: " << std::fixed << std::setprecision(4)
+                  << bestFitness << "\033[0m" << std::endl;
+    }
+}
+
+void EnhancedSnakeOptimizer::setCheckpoint(const std::string& path, uint64_t context, uint32_t every) {
+    checkpointPath = path;
+    checkpointContext = context;
+    checkpointEvery = std::max(1u, every);
+}
+
+bool EnhancedSnakeOptimizer::saveCheckpoint() const {
+    CheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kCheckpointMagic, sizeof(kCheckpointMagic));
+    header.context = checkpointContext;
+    header.populationSize = (uint32_t)population.size();
+    header.dimensions = (uint32_t)lower.size();
+    header.runIterations = runIterations;
+    header.iteration = iteration;
+    header.evaluations = evaluations;
+    header.rngKey = rng.GetKey();
+    header.rngStream = rng.GetStream();
+    header.rngPosition = rng.GetPosition();
+    header.streamKey = streams.empty() ? 0 : streams[0].GetKey();
+    header.bestFitness = bestFitness;
+    header.bestMale = (uint32_t)bestMale;
+    header.bestFemale = (uint32_t)bestFemale;
+    header.historyCount = (uint32_t)history.size();
+    
+    std::string temporary = checkpointPath + ".tmp";
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    auto writeSnake = [&](const Snake& snake) {
+        out.write(reinterpret_cast<const char*>(snake.position.data()), snake.position.size() * sizeof(double));
+        out.write(reinterpret_cast<const char*>(&snake.fitness), sizeof(double));
+    };
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const Snake& snake : population) {
+        writeSnake(snake);
+    }
+    for (const RngStream& stream : streams) {
+        uint64_t position = stream.GetPosition();
+        out.write(reinterpret_cast<const char*>(&position), sizeof(position));
+    }
+    out.write(reinterpret_cast<const char*>(bestParams.data()), bestParams.size() * sizeof(double));
+    for (const Snake& snake : history) {
+        writeSnake(snake);
+    }
+    out.close();
+    
+    // Replace the previous checkpoint only once this one is complete
+    return out && std::rename(temporary.c_str(), checkpointPath.c_str()) == 0;
+}
+
+bool EnhancedSnakeOptimizer::loadCheckpoint(int iterations) {
+    std::ifstream in(checkpointPath, std::ios::binary);
+    if (!in) {
+        std::cout << "⚠️  Optimizer checkpoint: no " << checkpointPath << ", starting afresh" << std::endl;
+        return false;
+    }
+    
+    CheckpointHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || memcmp(header.magic, kCheckpointMagic, sizeof(kCheckpointMagic)) != 0) {
+        std::cerr << "Optimizer checkpoint: " << checkpointPath << " is not a checkpoint file, starting afresh" << std::endl;
+        return false;
+    }
+    size_t dimensions = lower.size();
+    if (header.context != checkpointContext || header.populationSize != populationSize
+        || header.dimensions != dimensions || header.runIterations != std::max(0, iterations)
+        || header.rngKey != rng.GetKey() || header.rngStream != rng.GetStream()) {
+        std::cerr << "Optimizer checkpoint: " << checkpointPath << " is from a different run "
+                  << "(scenario, population, iterations or --RngSeed/--RngRun), starting afresh" << std::endl;
+        return false;
+    }
+    if (header.iteration < 0 || header.iteration > header.runIterations
+        || header.historyCount != (uint32_t)header.iteration
+        || header.bestMale >= populationSize || header.bestFemale >= populationSize) {
+        std::cerr << "Optimizer checkpoint: " << checkpointPath << " is damaged, starting afresh" << std::endl;
+        return false;
+    }
+    
+    auto readSnake = [&](Snake& snake) {
+        snake.position.resize(dimensions);
+        in.read(reinterpret_cast<char*>(snake.position.data()), dimensions * sizeof(double));
+        in.read(reinterpret_cast<char*>(&snake.fitness), sizeof(double));
+    };
+    std::vector<Snake> loadedPopulation(populationSize);
+    for (Snake& snake : loadedPopulation) {
+        readSnake(snake);
+    }
+    std::vector<uint64_t> positions(populationSize);
+    in.read(reinterpret_cast<char*>(positions.data()), positions.size() * sizeof(uint64_t));
+    std::vector<double> loadedBest(dimensions);
+    in.read(reinterpret_cast<char*>(loadedBest.data()), loadedBest.size() * sizeof(double));
+    std::vector<Snake> loadedHistory(header.historyCount);
+    for (Snake& snake : loadedHistory) {
+        readSnake(snake);
+    }
+    if (!in || in.peek() != std::ifstream::traits_type::eof()) {
+        std::cerr << "Optimizer checkpoint: " << checkpointPath << " is truncated, starting afresh" << std::endl;
+        return false;
+    }
+    
+    preparePool();
+    population.swap(loadedPopulation);
+    bestParams.swap(loadedBest);
+    history.swap(loadedHistory);
+    rng = RngStream(header.rngKey, header.rngStream, header.rngPosition);
+    streams.clear();
+    for (uint32_t i = 0; i < populationSize; i++) {
+        streams.emplace_back(header.streamKey, i, positions[i]);
+    }
+    bestMale = header.bestMale;
+    bestFemale = header.bestFemale;
+    bestFitness = header.bestFitness;
+    evaluations = header.evaluations;
+    runIterations = header.runIterations;
+    iteration = header.iteration;
+    
+    // Carry on where the interrupted step() would have: breed the next
+    // generation from the restored one
+    scoringPopulation = false;
+    running = iteration < runIterations;
+    if (running) {
+        beginGeneration();
+    }
+    return true;
+}
+
+std::vector<double> EnhancedSnakeOptimizer::optimize(int iterations, bool resume) {
+    EventEmitter& emitter = EventEmitter::Instance();
+    emitter.EmitEvent("optimization_start", 0);
+    
+    checkpointing = !checkpointPath.empty();
+    bool resumed = resume && checkpointing && loadCheckpoint(iterations);
+    if (!resumed) {
+        start(iterations, false);
+    }
+    std::cout << "\033[1;33m🧬 SNAKE OPTIMIZATION " << (resumed ? "RESUMED" : "STARTED") << " ("
+              << iterations << " iterations, " << populationSize << " snakes, "
+              << (fitnessEvaluator ? fitnessEvaluator->GetName() + " fitness"
+                                   : std::to_string(pool->GetThreadCount()) + " threads")
+              << ")\033[0m" << std::endl;
+    if (resumed) {
+        std::cout << "\033[33m  Continuing at iteration " << iteration << "/" << runIterations
+                  << " from " << checkpointPath << " (" << evaluations << " evaluations so far)\033[0m" << std::endl;
+    }
+    
+    while (!step(0)) {}
+    checkpointing = false;
+    
     emitter.EmitEvent("optimization_complete", iterations);
-    std::cout << "\033[1;32m✓ OPTIMIZATION COMPLETE\033[0m" << std::endl;
+    std::cout << "\033[1;32m✓ OPTIMIZATION COMPLETE (" << evaluations << " evaluations)\033[0m" << std::endl;
     
     printOptimizationResults(bestParams);
     return bestParams;
@@ -101,11 +547,27 @@ std::vector<double> EnhancedSnakeOptimizer::optimize(int iterations) {
 void EnhancedSnakeOptimizer::printOptimizationResults(const std::vector<double>& params) const {
     std::cout << "\n\033[1;32m✨ SNAKE OPTIMIZATION RESULTS:\033[0m" << std::endl;
     std::cout << "┌─────────────────────────────────────────────┐" << std::endl;
-    std::cout << "│ Energy Weight:   " << std::fixed << std::setw(10) 
+    std::cout << "│ Energy Weight:   " << std::fixed << std::setw(10)
               << std::setprecision(4) << getBestEnergyWeight(params) << " │" << std::endl;
-    std::cout << "│ Power Control:   " << std::fixed << std::setw(10) 
+    std::cout << "│ Power Control:   " << std::fixed << std::setw(10)
               << std::setprecision(4) << getBestPowerControl(params) << " │" << std::endl;
-    std::cout << "│ Sleep Ratio:     " << std::fixed << std::setw(10) 
+    std::cout << "│ Sleep Ratio:     " << std::fixed << std::setw(10)
               << std::setprecision(4) << getBestSleepRatio(params) << " │" << std::endl;
     std::cout << "└─────────────────────────────────────────────┘" << std::endl;
-}
\ No newline at end of file
+    
+    // Per-region parameters: the box shows region 0, nearest the sink
+    size_t width = lowerBounds.size();
+    size_t regions = params.size() / width;
+    if (regions > 1) {
+        const size_t kShown = 16;
+        std::cout << "  Regions, sink outwards (EW / PC / SR):" << std::endl;
+        for (size_t r = 0; r < std::min(regions, kShown); r++) {
+            std::cout << "  R" << std::left << std::setw(4) << r << std::right << std::setprecision(3)
+                      << params[r * width] << " / " << params[r * width + 1] << " / "
+                      << params[r * width + 2] << std::endl;
+        }
+        if (regions > kShown) {
+            std::cout << "  ... " << regions - kShown << " more" << std::endl;
+        }
+    }
+}
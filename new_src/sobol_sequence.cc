@@ -0,0 +1,65 @@
+#include "sobol_sequence.h"
+#include <algorithm>
+
+namespace {
+// new-joe-kuo-6.21201, dimensions 2-10: degree s, coefficients a and the
+// initial direction numbers m_1..m_s. Dimension 1 is van der Corput.
+struct DirectionParams {
+    uint32_t s;
+    uint32_t a;
+    uint32_t m[5];
+};
+
+const DirectionParams kJoeKuo[SobolSequence::kMaxDimensions - 1] = {
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+};
+}
+
+SobolSequence::SobolSequence(uint32_t dimensionCount)
+    : dimensions(std::max(1u, std::min(dimensionCount, kMaxDimensions))), index(0),
+      direction(dimensions * kBits), state(dimensions, 0) {
+    for (uint32_t k = 0; k < kBits; k++) {
+        direction[k] = 1u << (kBits - 1 - k);
+    }
+    
+    for (uint32_t d = 1; d < dimensions; d++) {
+        const DirectionParams& p = kJoeKuo[d - 1];
+        uint32_t* v = &direction[d * kBits];
+        for (uint32_t k = 0; k < kBits; k++) {
+            if (k < p.s) {
+                v[k] = p.m[k] << (kBits - 1 - k);
+                continue;
+            }
+            v[k] = v[k - p.s] ^ (v[k - p.s] >> p.s);
+            for (uint32_t l = 1; l < p.s; l++) {
+                if ((p.a >> (p.s - 1 - l)) & 1) {
+                    v[k] ^= v[k - l];
+                }
+            }
+        }
+    }
+}
+
+void SobolSequence::Next(std::vector<double>& point) {
+    // Gray code: point i differs from point i-1 in the direction number of
+    // the lowest zero bit of i-1
+    uint32_t bit = 0;
+    for (uint64_t i = index; (i & 1) && bit < kBits - 1; i >>= 1) {
+        bit++;
+    }
+    index++;
+    
+    point.resize(dimensions);
+    for (uint32_t d = 0; d < dimensions; d++) {
+        state[d] ^= direction[d * kBits + bit];
+        point[d] = state[d] * (1.0 / 4294967296.0);
+    }
+}
@@ -0,0 +1,77 @@
+#include "spatial_grid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid()
+    : originX(0.0), originY(0.0), cellSize(1.0), cellsX(1), cellsY(1), buckets(1) {}
+
+void SpatialGrid::Configure(double minX, double minY, double maxX, double maxY, double size) {
+    originX = minX;
+    originY = minY;
+    cellSize = std::max(size, 1e-6);
+    cellsX = std::max(1, static_cast<int>(std::ceil((maxX - minX) / cellSize)));
+    cellsY = std::max(1, static_cast<int>(std::ceil((maxY - minY) / cellSize)));
+
+    buckets.assign(static_cast<size_t>(cellsX) * cellsY, std::vector<uint32_t>());
+    posX.clear();
+    posY.clear();
+    bucketOf.clear();
+}
+
+int SpatialGrid::CellX(double x) const {
+    int cx = static_cast<int>(std::floor((x - originX) / cellSize));
+    return std::max(0, std::min(cellsX - 1, cx));
+}
+
+int SpatialGrid::CellY(double y) const {
+    int cy = static_cast<int>(std::floor((y - originY) / cellSize));
+    return std::max(0, std::min(cellsY - 1, cy));
+}
+
+void SpatialGrid::Insert(uint32_t id, double x, double y) {
+    if (id >= bucketOf.size()) {
+        posX.resize(id + 1, 0.0);
+        posY.resize(id + 1, 0.0);
+        bucketOf.resize(id + 1, -1);
+    }
+    if (bucketOf[id] >= 0) Remove(id);
+
+    int bucket = CellY(y) * cellsX + CellX(x);
+    buckets[bucket].push_back(id);
+    bucketOf[id] = bucket;
+    posX[id] = x;
+    posY[id] = y;
+}
+
+void SpatialGrid::Remove(uint32_t id) {
+    if (!Contains(id)) return;
+
+    std::vector<uint32_t>& bucket = buckets[bucketOf[id]];
+    auto it = std::find(bucket.begin(), bucket.end(), id);
+    if (it != bucket.end()) {
+        *it = bucket.back();
+        bucket.pop_back();
+    }
+    bucketOf[id] = -1;
+}
+
+bool SpatialGrid::Contains(uint32_t id) const {
+    return id < bucketOf.size() && bucketOf[id] >= 0;
+}
+
+void SpatialGrid::ForEachInRadius(double x, double y, double radius,
+                                  const std::function<void(uint32_t)>& visit) const {
+    int x0 = CellX(x - radius), x1 = CellX(x + radius);
+    int y0 = CellY(y - radius), y1 = CellY(y + radius);
+    double r2 = radius * radius;
+
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            for (uint32_t id : buckets[cy * cellsX + cx]) {
+                double dx = posX[id] - x;
+                double dy = posY[id] - y;
+                if (dx * dx + dy * dy <= r2) visit(id);
+            }
+        }
+    }
+}
@@ -0,0 +1,189 @@
+#include "surrogate_optimizer.h"
+#include "snake_optimizer.h"
+#include "fitness_evaluator.h"
+#include "sobol_sequence.h"
+#include "thread_pool.h"
+#include "event_emitter.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+// Hyperparameter settings tried per model fit
+const uint32_t kHyperparameterTrials = 128;
+
+// Expected-improvement candidates per round: spread over the box, and
+// scattered (Gaussian, per unit of each range) around the best points
+const size_t kGlobalCandidates = 1024;
+const size_t kLocalCandidates = 512;
+const size_t kLocalCentres = 4;
+const double kLocalSpread[] = {0.02, 0.05, 0.1};
+}
+
+SurrogateOptimizer::SurrogateOptimizer(FitnessEvaluator* fitnessEvaluator)
+    : evaluator(fitnessEvaluator), budget(24), batchSize(8), initialSamples(0), threadCount(0),
+      rng(0, 0), bestParams(EnhancedSnakeOptimizer::getDefaultParams()), bestFitness(0.0), rounds(0) {}
+
+SurrogateOptimizer::~SurrogateOptimizer() = default;
+
+std::vector<double> SurrogateOptimizer::toParams(const std::vector<double>& unit) const {
+    const std::vector<double>& lower = EnhancedSnakeOptimizer::getLowerBounds();
+    const std::vector<double>& upper = EnhancedSnakeOptimizer::getUpperBounds();
+    std::vector<double> params(unit.size());
+    for (size_t d = 0; d < unit.size(); d++) {
+        params[d] = lower[d] + (upper[d] - lower[d]) * unit[d];
+    }
+    return params;
+}
+
+void SurrogateOptimizer::evaluate(const std::vector<std::vector<double>>& batch) {
+    std::vector<std::vector<double>> candidates(batch.size());
+    for (size_t i = 0; i < batch.size(); i++) {
+        candidates[i] = toParams(batch[i]);
+    }
+    std::vector<double> fitness;
+    evaluator->Evaluate(candidates, fitness);
+    
+    for (size_t i = 0; i < batch.size(); i++) {
+        double value = i < fitness.size() ? fitness[i] : 0.0;
+        points.push_back(batch[i]);
+        values.push_back(value);
+        if (points.size() == 1 || value > bestFitness) {
+            bestFitness = value;
+            bestParams = candidates[i];
+        }
+    }
+}
+
+void SurrogateOptimizer::selectBatch(size_t count, std::vector<std::vector<double>>& batch) {
+    size_t dimensions = EnhancedSnakeOptimizer::getLowerBounds().size();
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    
+    // Quasi-random points, shifted by a random offset each round so rounds
+    // do not search the same set (Cranley-Patterson rotation)
+    std::vector<std::vector<double>> candidates;
+    candidates.reserve(kGlobalCandidates + kLocalCandidates);
+    SobolSequence sequence((uint32_t)dimensions);
+    std::vector<double> shift(dimensions);
+    for (double& s : shift) {
+        s = unit(rng);
+    }
+    std::vector<double> point;
+    for (size_t c = 0; c < kGlobalCandidates; c++) {
+        sequence.Next(point);
+        for (size_t d = 0; d < dimensions; d++) {
+            point[d] = std::fmod(point[d] + shift[d], 1.0);
+        }
+        candidates.push_back(point);
+    }
+    
+    // Around the best few observed points, at several radii
+    std::vector<size_t> order(values.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    size_t centres = std::min(kLocalCentres, order.size());
+    std::partial_sort(order.begin(), order.begin() + centres, order.end(),
+                      [&](size_t a, size_t b) { return values[a] > values[b]; });
+    size_t radii = sizeof(kLocalSpread) / sizeof(kLocalSpread[0]);
+    for (size_t c = 0; c < kLocalCandidates && centres > 0; c++) {
+        const std::vector<double>& centre = points[order[c % centres]];
+        double spread = kLocalSpread[(c / centres) % radii];
+        for (size_t d = 0; d < dimensions; d++) {
+            point[d] = std::max(0.0, std::min(1.0, centre[d] + spread * normal(rng)));
+        }
+        candidates.push_back(point);
+    }
+    
+    // Kriging believer: each pick is added to a copy of the model at its
+    // predicted value before the next is chosen
+    GaussianProcess believer = model;
+    std::vector<double> improvement(candidates.size());
+    batch.clear();
+    for (size_t q = 0; q < count; q++) {
+        pool->ParallelFor(candidates.size(), [&](size_t c) {
+            improvement[c] = believer.ExpectedImprovement(candidates[c], bestFitness);
+        });
+        size_t pick = std::max_element(improvement.begin(), improvement.end()) - improvement.begin();
+        batch.push_back(candidates[pick]);
+        
+        double mean;
+        double stddev;
+        believer.Predict(candidates[pick], mean, stddev);
+        believer.AddObservation(candidates[pick], mean);
+        candidates.erase(candidates.begin() + pick);
+        improvement.pop_back();
+    }
+}
+
+std::vector<double> SurrogateOptimizer::optimize() {
+    EventEmitter& emitter = EventEmitter::Instance();
+    emitter.EmitEvent("optimization_start", 0);
+    
+    if (!pool || (threadCount != 0 && pool->GetThreadCount() != threadCount)) {
+        pool.reset(new ThreadPool(threadCount));
+    }
+    points.clear();
+    values.clear();
+    rounds = 0;
+    
+    size_t dimensions = EnhancedSnakeOptimizer::getLowerBounds().size();
+    uint32_t initial = initialSamples > 0 ? initialSamples
+                                          : std::max<uint32_t>(2 * dimensions + 2, batchSize);
+    initial = std::max(1u, std::min(initial, budget));
+    std::cout << "\033[1;33m🧬 SURROGATE OPTIMIZATION STARTED (Gaussian process + expected improvement, "
+              << budget << " evaluations, " << initial << " initial, " << batchSize << " per round)\033[0m"
+              << std::endl;
+    
+    // Space-filling start, with the defaults as the first point
+    std::vector<std::vector<double>> batch;
+    const std::vector<double>& lower = EnhancedSnakeOptimizer::getLowerBounds();
+    const std::vector<double>& upper = EnhancedSnakeOptimizer::getUpperBounds();
+    const std::vector<double>& defaults = EnhancedSnakeOptimizer::getDefaultParams();
+    std::vector<double> point(dimensions);
+    for (size_t d = 0; d < dimensions; d++) {
+        point[d] = (defaults[d] - lower[d]) / (upper[d] - lower[d]);
+    }
+    batch.push_back(point);
+    SobolSequence sequence((uint32_t)dimensions);
+    while (batch.size() < initial) {
+        sequence.Next(point);
+        batch.push_back(point);
+    }
+    evaluate(batch);
+    
+    uint32_t totalRounds = budget > initial ? (budget - initial + batchSize - 1) / batchSize : 0;
+    while (points.size() < budget) {
+        model.SetData(points, values);
+        model.FitHyperparameters(kHyperparameterTrials);
+        
+        size_t count = std::min<size_t>(batchSize, budget - points.size());
+        selectBatch(count, batch);
+        evaluate(batch);
+        
+        EventEmitter::Instance().EmitEvent("optimization_progress", rounds, -1, totalRounds);
+        std::cout << "\033[33m  Round " << rounds << "/" << totalRounds << " | Evaluations: " << points.size()
+                  << " | Fitness: " << std::fixed << std::setprecision(4) << bestFitness << "\033[0m" << std::endl;
+        rounds++;
+    }
+    
+    emitter.EmitEvent("optimization_complete", rounds);
+    std::cout << "\033[1;32m✓ OPTIMIZATION COMPLETE (" << points.size() << " evaluations)\033[0m" << std::endl;
+    printResults();
+    return bestParams;
+}
+
+void SurrogateOptimizer::printResults() const {
+    std::cout << "\n\033[1;32m✨ SURROGATE OPTIMIZATION RESULTS:\033[0m" << std::endl;
+    std::cout << "├─ Energy Weight:          " << std::fixed << std::setprecision(4) << bestParams[0] << std::endl;
+    std::cout << "├─ Power Control:          " << bestParams[1] << std::endl;
+    std::cout << "├─ Sleep Ratio:            " << bestParams[2] << std::endl;
+    std::cout << "├─ Fitness:                " << bestFitness << std::endl;
+    std::cout << "├─ Evaluations:            " << points.size() << " (" << rounds << " model rounds)" << std::endl;
+    std::cout << "└─ Model Length Scales:    ";
+    const std::vector<double>& scales = model.GetLengthScales();
+    for (size_t d = 0; d < scales.size(); d++) {
+        std::cout << (d ? " / " : "") << std::setprecision(3) << scales[d];
+    }
+    std::cout << (scales.empty() ? "(no model)" : "") << std::endl;
+}
@@ -0,0 +1,337 @@
+#include "telemetry_sink.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const char kTelemetryMagic[8] = {'W', 'S', 'N', 'T', 'E', 'L', '0', '1'};
+const uint32_t kTelemetryVersion = 2;
+const uint32_t kSlotTruncated = 0x1;
+const uint32_t kSlotHasMore = 0x2;
+const uint32_t kSlotContinuation = 0x4;
+
+struct TelemetrySlotHeader {
+    std::atomic<uint64_t> sequence;
+    double simTime;
+    uint32_t length;
+    uint32_t flags;
+};
+
+static_assert(sizeof(TelemetrySlotHeader) == 24, "slot header layout changed");
+
+uint64_t DoubleBits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+std::string ShmName(const std::string& name) {
+    return (!name.empty() && name[0] == '/') ? name : "/" + name;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Writer
+// ---------------------------------------------------------------------------
+
+TelemetrySink::TelemetrySink()
+    : header(nullptr), base(nullptr), mappedSize(0), eventsPublished(0), eventsTruncated(0) {}
+
+TelemetrySink::~TelemetrySink() {
+    Close();
+}
+
+bool TelemetrySink::Open(const std::string& name, uint32_t nodeCapacity,
+                         uint32_t slotCount, uint32_t slotSize) {
+    Close();
+
+    if (slotCount == 0 || slotSize <= sizeof(TelemetrySlotHeader) || slotSize % 8 != 0) {
+        std::cerr << "Telemetry: invalid ring geometry (" << slotCount << " x "
+                  << slotSize << ")" << std::endl;
+        return false;
+    }
+
+    shmName = ShmName(name);
+
+    uint64_t nodeTableOffset = sizeof(TelemetryHeader);
+    uint64_t ringOffset = nodeTableOffset + (uint64_t)nodeCapacity * sizeof(TelemetryNodeRecord);
+    size_t totalSize = ringOffset + (uint64_t)slotCount * slotSize;
+
+    // Start from a fresh segment so readers of a previous run see it vanish.
+    shm_unlink(shmName.c_str());
+    int fd = shm_open(shmName.c_str(), O_CREAT | O_RDWR | O_EXCL, 0644);
+    if (fd < 0) {
+        std::cerr << "Telemetry: shm_open(" << shmName << ") failed: "
+                  << strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (ftruncate(fd, totalSize) != 0) {
+        std::cerr << "Telemetry: ftruncate failed: " << strerror(errno) << std::endl;
+        close(fd);
+        shm_unlink(shmName.c_str());
+        return false;
+    }
+
+    void* mem = mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        std::cerr << "Telemetry: mmap failed: " << strerror(errno) << std::endl;
+        shm_unlink(shmName.c_str());
+        return false;
+    }
+
+    // ftruncate zero-fills, so every slot/record starts with sequence 0.
+    base = static_cast<uint8_t*>(mem);
+    mappedSize = totalSize;
+    header = reinterpret_cast<TelemetryHeader*>(base);
+
+    memcpy(header->magic, kTelemetryMagic, sizeof(kTelemetryMagic));
+    header->version = kTelemetryVersion;
+    header->headerSize = sizeof(TelemetryHeader);
+    header->nodeCapacity = nodeCapacity;
+    header->nodeRecordSize = sizeof(TelemetryNodeRecord);
+    header->slotCount = slotCount;
+    header->slotSize = slotSize;
+    header->nodeTableOffset = nodeTableOffset;
+    header->ringOffset = ringOffset;
+    header->writerPid = static_cast<uint32_t>(getpid());
+    header->writeSeq.store(0, std::memory_order_relaxed);
+    header->simTimeBits.store(DoubleBits(0.0), std::memory_order_relaxed);
+
+    TelemetryNodeRecord* records = reinterpret_cast<TelemetryNodeRecord*>(base + nodeTableOffset);
+    for (uint32_t i = 0; i < nodeCapacity; ++i) {
+        records[i].nodeId = i;
+        records[i].energy = -1.0;
+        records[i].alive = 1;
+    }
+
+    header->writerState.store(1, std::memory_order_release);
+    eventsPublished = 0;
+    eventsTruncated = 0;
+    return true;
+}
+
+void TelemetrySink::Close() {
+    if (!header) return;
+
+    header->writerState.store(2, std::memory_order_release);
+    munmap(base, mappedSize);
+
+    header = nullptr;
+    base = nullptr;
+    mappedSize = 0;
+}
+
+void TelemetrySink::PublishEvent(const std::string& line, double simTime) {
+    if (!header) return;
+
+    // Split over as many slots as the line needs; only an event longer than
+    // the whole ring is cut.
+    size_t capacity = header->slotSize - sizeof(TelemetrySlotHeader);
+    size_t length = line.size();
+    uint64_t fragments = std::max<uint64_t>(1, (length + capacity - 1) / capacity);
+    uint32_t truncated = 0;
+    if (fragments > header->slotCount) {
+        fragments = header->slotCount;
+        length = fragments * capacity;
+        truncated = kSlotTruncated;
+        eventsTruncated++;
+    }
+
+    uint64_t seq = header->writeSeq.load(std::memory_order_relaxed);
+    for (uint64_t i = 0; i < fragments; ++i) {
+        uint8_t* slot = base + header->ringOffset + ((seq + i) % header->slotCount) * header->slotSize;
+        TelemetrySlotHeader* slotHeader = reinterpret_cast<TelemetrySlotHeader*>(slot);
+
+        size_t offset = i * capacity;
+        size_t chunk = std::min(capacity, length - offset);
+        uint32_t flags = (i > 0 ? kSlotContinuation : 0) |
+                         (i + 1 < fragments ? kSlotHasMore : truncated);
+
+        slotHeader->sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slotHeader->simTime = simTime;
+        slotHeader->length = static_cast<uint32_t>(chunk);
+        slotHeader->flags = flags;
+        memcpy(slot + sizeof(TelemetrySlotHeader), line.data() + offset, chunk);
+
+        slotHeader->sequence.store(seq + i + 1, std::memory_order_release);
+    }
+
+    header->simTimeBits.store(DoubleBits(simTime), std::memory_order_relaxed);
+    header->writeSeq.store(seq + fragments, std::memory_order_release);
+    eventsPublished++;
+}
+
+void TelemetrySink::UpdateNode(uint32_t nodeId, double energy, bool alive, double simTime) {
+    if (!header || nodeId >= header->nodeCapacity) return;
+
+    TelemetryNodeRecord* record = reinterpret_cast<TelemetryNodeRecord*>(
+        base + header->nodeTableOffset) + nodeId;
+
+    uint32_t seq = record->seq.load(std::memory_order_relaxed);
+    record->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    record->energy = energy;
+    record->updateTime = simTime;
+    record->alive = alive ? 1 : 0;
+
+    record->seq.store(seq + 2, std::memory_order_release);
+}
+
+// ---------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------
+
+TelemetryReader::TelemetryReader()
+    : header(nullptr), base(nullptr), mappedSize(0), nextSeq(0), eventsDropped(0) {}
+
+TelemetryReader::~TelemetryReader() {
+    Detach();
+}
+
+bool TelemetryReader::Attach(const std::string& name, bool fromStart) {
+    Detach();
+
+    int fd = shm_open(ShmName(name).c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TelemetryHeader)) {
+        close(fd);
+        return false;
+    }
+
+    void* mem = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) return false;
+
+    const TelemetryHeader* candidate = static_cast<const TelemetryHeader*>(mem);
+    if (memcmp(candidate->magic, kTelemetryMagic, sizeof(kTelemetryMagic)) != 0 ||
+        candidate->version != kTelemetryVersion ||
+        candidate->ringOffset + (uint64_t)candidate->slotCount * candidate->slotSize >
+            (uint64_t)st.st_size) {
+        munmap(mem, st.st_size);
+        return false;
+    }
+
+    base = static_cast<const uint8_t*>(mem);
+    mappedSize = st.st_size;
+    header = candidate;
+    eventsDropped = 0;
+
+    uint64_t head = header->writeSeq.load(std::memory_order_acquire);
+    uint64_t oldest = head > header->slotCount ? head - header->slotCount : 0;
+    nextSeq = fromStart ? oldest : head;
+    return true;
+}
+
+void TelemetryReader::Detach() {
+    if (!header) return;
+
+    munmap(const_cast<uint8_t*>(base), mappedSize);
+    header = nullptr;
+    base = nullptr;
+    mappedSize = 0;
+}
+
+bool TelemetryReader::IsWriterFinished() const {
+    return header && header->writerState.load(std::memory_order_acquire) == 2;
+}
+
+size_t TelemetryReader::Poll(const std::function<void(double, const std::string&)>& onEvent,
+                             size_t maxEvents) {
+    if (!header) return 0;
+
+    uint64_t head = header->writeSeq.load(std::memory_order_acquire);
+    uint64_t oldest = head > header->slotCount ? head - header->slotCount : 0;
+    if (nextSeq < oldest) {
+        eventsDropped += oldest - nextSeq;
+        nextSeq = oldest;
+    }
+
+    size_t delivered = 0;
+    std::string line;
+    std::string fragment;
+    bool assembling = false;
+    double eventTime = 0.0;
+
+    while (nextSeq < head && delivered < maxEvents) {
+        const uint8_t* slot = base + header->ringOffset + (nextSeq % header->slotCount) * header->slotSize;
+        const TelemetrySlotHeader* slotHeader = reinterpret_cast<const TelemetrySlotHeader*>(slot);
+
+        uint64_t before = slotHeader->sequence.load(std::memory_order_acquire);
+        double simTime = slotHeader->simTime;
+        uint32_t flags = slotHeader->flags;
+        uint32_t length = std::min<uint32_t>(slotHeader->length,
+                                             header->slotSize - sizeof(TelemetrySlotHeader));
+        fragment.assign(reinterpret_cast<const char*>(slot + sizeof(TelemetrySlotHeader)), length);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = slotHeader->sequence.load(std::memory_order_relaxed);
+        nextSeq++;
+
+        if (before != nextSeq || after != before) {
+            // Overwritten by the writer while we were behind.
+            eventsDropped++;
+            assembling = false;
+            continue;
+        }
+
+        if (flags & kSlotContinuation) {
+            // Tail of an event whose head was lost or preceded the attach point
+            if (!assembling) continue;
+            line += fragment;
+        } else {
+            line = fragment;
+            eventTime = simTime;
+        }
+
+        assembling = (flags & kSlotHasMore) != 0;
+        if (!assembling) {
+            onEvent(eventTime, line);
+            delivered++;
+        }
+    }
+
+    // head only advances by whole events and delivered only by completed
+    // ones, so the loop never stops inside an event.
+    return delivered;
+}
+
+bool TelemetryReader::ReadNode(uint32_t nodeId, TelemetryNodeRecord& out) const {
+    if (!header || nodeId >= header->nodeCapacity) return false;
+
+    const TelemetryNodeRecord* record = reinterpret_cast<const TelemetryNodeRecord*>(
+        base + header->nodeTableOffset) + nodeId;
+
+    for (int attempt = 0; attempt < 64; ++attempt) {
+        uint32_t before = record->seq.load(std::memory_order_acquire);
+        if (before & 1) continue;
+
+        out.nodeId = record->nodeId;
+        out.energy = record->energy;
+        out.updateTime = record->updateTime;
+        out.alive = record->alive;
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (record->seq.load(std::memory_order_relaxed) == before) {
+            out.seq.store(before, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t TelemetryReader::GetNodeCapacity() const {
+    return header ? header->nodeCapacity : 0;
+}
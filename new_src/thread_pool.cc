@@ -0,0 +1,80 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(uint32_t threads)
+    : job(nullptr), jobCount(0), nextIndex(0), generation(0), busyWorkers(0), stopping(false) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    // The caller works too, so one fewer background thread
+    for (uint32_t i = 1; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::RunItems() {
+    for (;;) {
+        size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+        if (index >= jobCount) break;
+        (*job)(index);
+    }
+}
+
+void ThreadPool::WorkerLoop() {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            busyWorkers++;
+        }
+        
+        RunItems();
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers--;
+        }
+        done.notify_one();
+    }
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) return;
+    if (workers.empty() || count == 1) {
+        for (size_t i = 0; i < count; i++) fn(i);
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobCount = count;
+        nextIndex.store(0, std::memory_order_relaxed);
+        generation++;
+    }
+    wake.notify_all();
+    
+    RunItems();
+    
+    // Workers that woke late find no indices left and drop straight out;
+    // ones that never woke for this generation never touch the job
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return busyWorkers == 0; });
+    job = nullptr;
+    jobCount = 0;
+}
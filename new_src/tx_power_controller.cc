@@ -0,0 +1,254 @@
+#include "tx_power_controller.h"
+#include "event_emitter.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+namespace {
+
+const double kLossSmoothing = 0.2;
+const double kMinMarginDb = 3.0;
+const double kMaxMarginDb = 20.0;
+
+// Recent frames remembered per transmitter; covers retries and every
+// receiver of a broadcast
+const uint32_t kSentFrames = 16;
+
+} // namespace
+
+TxPowerController::TxPowerController()
+    : m_minPower(0.0), m_maxPower(20.0), m_rxSensitivity(-101.0), m_marginDb(10.0),
+      m_redundancy(1), m_interval(0.0), m_updates(0) {}
+
+void TxPowerController::Configure(NetDeviceContainer& devices, double minPowerDbm, double maxPowerDbm,
+                                  double rxSensitivityDbm, double powerControl, uint32_t redundancy) {
+    m_devices = devices;
+    m_minPower = minPowerDbm;
+    m_maxPower = maxPowerDbm;
+    m_rxSensitivity = rxSensitivityDbm;
+    m_redundancy = redundancy;
+    SetPowerControl(powerControl);
+    
+    uint32_t n = devices.GetN();
+    m_alive.assign(n, 1);
+    m_txPower.assign(n, maxPowerDbm);
+    m_loss.assign(static_cast<size_t>(n) * n, -1.0);
+    m_sent.assign(static_cast<size_t>(n) * kSentFrames, SentFrame{std::numeric_limits<uint64_t>::max(), 0.0});
+    m_sentNext.assign(n, 0);
+    m_macToNode.clear();
+    
+    for (uint32_t i = 0; i < n; ++i) {
+        m_macToNode[Mac48Address::ConvertFrom(devices.Get(i)->GetAddress())] = i;
+        
+        Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(devices.Get(i));
+        if (!device) continue;
+        device->GetPhy()->TraceConnectWithoutContext("MonitorSnifferTx",
+            MakeCallback(&TxPowerController::OnSnifferTx, this).Bind(i));
+        device->GetPhy()->TraceConnectWithoutContext("MonitorSnifferRx",
+            MakeCallback(&TxPowerController::OnSnifferRx, this).Bind(i));
+        ApplyTxPower(i, maxPowerDbm);
+    }
+}
+
+void TxPowerController::Start(double firstUpdate, double updateInterval) {
+    m_interval = updateInterval;
+    Simulator::Schedule(Seconds(firstUpdate), &TxPowerController::PeriodicUpdate, this);
+}
+
+void TxPowerController::OnSnifferTx(uint32_t sender, Ptr<const Packet> packet, uint16_t channelFreqMhz,
+                                    WifiTxVector txVector, MpduInfo mpdu, uint16_t staId) {
+    (void)channelFreqMhz;
+    (void)txVector;
+    (void)mpdu;
+    (void)staId;
+    
+    uint32_t& next = m_sentNext[sender];
+    m_sent[static_cast<size_t>(sender) * kSentFrames + next] = SentFrame{packet->GetUid(), m_txPower[sender]};
+    next = (next + 1) % kSentFrames;
+}
+
+void TxPowerController::OnSnifferRx(uint32_t receiver, Ptr<const Packet> packet, uint16_t channelFreqMhz,
+                                    WifiTxVector txVector, MpduInfo mpdu,
+                                    SignalNoiseDbm signalNoise, uint16_t staId) {
+    (void)channelFreqMhz;
+    (void)txVector;
+    (void)mpdu;
+    (void)staId;
+    
+    WifiMacHeader header;
+    if (packet->PeekHeader(header) == 0 || header.IsCtl()) return; // ACK/CTS carry no transmitter
+    
+    auto it = m_macToNode.find(header.GetAddr2());
+    if (it == m_macToNode.end()) return;
+    
+    uint32_t sender = it->second;
+    uint32_t n = m_devices.GetN();
+    
+    // The power this frame left at, newest record first
+    uint64_t uid = packet->GetUid();
+    const SentFrame* sent = &m_sent[static_cast<size_t>(sender) * kSentFrames];
+    double txPower = std::numeric_limits<double>::quiet_NaN();
+    for (uint32_t k = 1; k <= kSentFrames; ++k) {
+        const SentFrame& frame = sent[(m_sentNext[sender] + kSentFrames - k) % kSentFrames];
+        if (frame.uid == uid) {
+            txPower = frame.txPowerDbm;
+            break;
+        }
+    }
+    if (std::isnan(txPower)) return;
+    double sample = txPower - signalNoise.signal;
+    
+    // Links are treated as symmetric; both directions share one estimate.
+    double& ab = m_loss[static_cast<size_t>(sender) * n + receiver];
+    double& ba = m_loss[static_cast<size_t>(receiver) * n + sender];
+    ab = (ab < 0.0) ? sample : ab + kLossSmoothing * (sample - ab);
+    ba = ab;
+}
+
+double TxPowerController::LinkLoss(uint32_t a, uint32_t b) const {
+    return m_loss[static_cast<size_t>(a) * m_devices.GetN() + b];
+}
+
+void TxPowerController::SetPowerControl(double powerControl) {
+    powerControl = std::max(0.0, std::min(1.0, powerControl));
+    m_marginDb = kMaxMarginDb - powerControl * (kMaxMarginDb - kMinMarginDb);
+    m_nodeMarginDb.clear();
+    if (m_updates > 0) {
+        Update();
+    }
+}
+
+void TxPowerController::SetPowerControl(const std::vector<double>& powerControl) {
+    if (powerControl.empty()) return;
+    
+    double sum = 0.0;
+    m_nodeMarginDb.resize(powerControl.size());
+    for (size_t i = 0; i < powerControl.size(); ++i) {
+        double pc = std::max(0.0, std::min(1.0, powerControl[i]));
+        m_nodeMarginDb[i] = kMaxMarginDb - pc * (kMaxMarginDb - kMinMarginDb);
+        sum += m_nodeMarginDb[i];
+    }
+    m_marginDb = sum / powerControl.size();
+    if (m_updates > 0) {
+        Update();
+    }
+}
+
+void TxPowerController::NodeDied(uint32_t nodeId) {
+    if (nodeId >= m_alive.size() || !m_alive[nodeId]) return;
+    
+    m_alive[nodeId] = 0;
+    Update();
+}
+
+void TxPowerController::PeriodicUpdate() {
+    Update();
+    if (m_interval > 0.0) {
+        Simulator::Schedule(Seconds(m_interval), &TxPowerController::PeriodicUpdate, this);
+    }
+}
+
+void TxPowerController::Update() {
+    uint32_t n = m_devices.GetN();
+    const double inf = std::numeric_limits<double>::infinity();
+    
+    // Loss each node must overcome; starts at its redundancy-th nearest
+    // heard neighbour.
+    std::vector<double> needed(n, -inf);
+    std::vector<double> losses;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (!m_alive[i]) continue;
+        
+        losses.clear();
+        for (uint32_t j = 0; j < n; ++j) {
+            if (j != i && m_alive[j] && LinkLoss(i, j) >= 0.0) losses.push_back(LinkLoss(i, j));
+        }
+        if (losses.empty()) {
+            needed[i] = inf; // nothing heard yet: stay at full power
+            continue;
+        }
+        size_t k = std::min<size_t>(std::max<uint32_t>(m_redundancy, 1), losses.size()) - 1;
+        std::nth_element(losses.begin(), losses.begin() + k, losses.end());
+        needed[i] = losses[k];
+    }
+    
+    // Prim's MST over heard links between alive nodes (dense, O(N^2)).
+    std::vector<double> best(n, inf);
+    std::vector<int32_t> parent(n, -1);
+    std::vector<uint8_t> inTree(n, 0);
+    for (uint32_t root = 0; root < n; ++root) {
+        if (!m_alive[root] || inTree[root]) continue;
+        
+        best[root] = 0.0;
+        while (true) {
+            uint32_t u = n;
+            for (uint32_t v = 0; v < n; ++v) {
+                if (m_alive[v] && !inTree[v] && best[v] < inf && (u == n || best[v] < best[u])) u = v;
+            }
+            if (u == n) break;
+            
+            inTree[u] = 1;
+            if (parent[u] >= 0) {
+                needed[u] = std::max(needed[u], best[u]);
+                needed[parent[u]] = std::max(needed[parent[u]], best[u]);
+            }
+            for (uint32_t v = 0; v < n; ++v) {
+                double loss = LinkLoss(u, v);
+                if (m_alive[v] && !inTree[v] && loss >= 0.0 && loss < best[v]) {
+                    best[v] = loss;
+                    parent[v] = static_cast<int32_t>(u);
+                }
+            }
+        }
+    }
+    
+    for (uint32_t i = 0; i < n; ++i) {
+        if (!m_alive[i]) continue;
+        double margin = i < m_nodeMarginDb.size() ? m_nodeMarginDb[i] : m_marginDb;
+        double power = needed[i] + m_rxSensitivity + margin;
+        ApplyTxPower(i, std::max(m_minPower, std::min(m_maxPower, power)));
+    }
+    
+    m_updates++;
+    EventEmitter::Instance().EmitMetric("avg_tx_power", GetAverageTxPower(), "dBm");
+}
+
+void TxPowerController::ApplyTxPower(uint32_t nodeId, double dbm) {
+    m_txPower[nodeId] = dbm;
+    
+    Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(m_devices.Get(nodeId));
+    if (!device) return;
+    device->GetPhy()->SetTxPowerStart(dbm);
+    device->GetPhy()->SetTxPowerEnd(dbm);
+}
+
+double TxPowerController::GetAverageTxPower() const {
+    double sum = 0.0;
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < m_txPower.size(); ++i) {
+        if (!m_alive[i]) continue;
+        sum += m_txPower[i];
+        count++;
+    }
+    return (count > 0) ? sum / count : 0.0;
+}
+
+void TxPowerController::PrintReport() const {
+    double lowest = m_maxPower, highest = m_minPower;
+    for (uint32_t i = 0; i < m_txPower.size(); ++i) {
+        if (!m_alive[i]) continue;
+        lowest = std::min(lowest, m_txPower[i]);
+        highest = std::max(highest, m_txPower[i]);
+    }
+    
+    std::cout << "\n\033[1;33m📶 TRANSMIT POWER CONTROL:\033[0m" << std::endl;
+    std::cout << "├─ Target Link Margin:     " << std::fixed << std::setprecision(1)
+              << m_marginDb << " dB" << std::endl;
+    std::cout << "├─ Tx Power (alive):       " << GetAverageTxPower() << " dBm avg, "
+              << lowest << "-" << highest << " dBm" << std::endl;
+    std::cout << "└─ Updates:                " << m_updates << std::endl;
+}
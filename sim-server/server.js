@@ -193,6 +193,20 @@ function updateNodeStatesFromEvent(event) {
   }
 }
 
+// Apply a delta-encoded node state frame
+function applyFrame(frame) {
+  (frame.nodes || []).forEach(delta => {
+    if (!nodeStates.has(delta.id)) return;
+    const node = nodeStates.get(delta.id);
+    if (delta.energy !== undefined) node.energy = delta.energy;
+    if (delta.status === 'dead' && node.alive) {
+      node.alive = false;
+      node.deathTime = frame.time;
+      node.color = '#666666';
+    }
+  });
+}
+
 // Broadcast to specific client
 function sendToClient(clientId, data) {
   const client = clients.get(clientId);
@@ -693,6 +707,19 @@ function processLine(line) {
       const event = JSON.parse(line);
       eventCount++;
 
+      // Coalesced per-tick node state frames carry only the changed nodes
+      if (event.type === 'frame') {
+        applyFrame(event);
+        broadcastToType('visualization', {
+          type: "frame",
+          frame: event.frame,
+          time: event.time,
+          nodes: event.nodes,
+          timestamp: Date.now()
+        });
+        return;
+      }
+
       // Add server metadata
       event._id = eventCount;
       event._serverTime = Date.now();
@@ -0,0 +1,56 @@
+#include "fitness_evaluator.h"
+#include "rng_stream_manager.h"
+#include "snake_optimizer.h"
+#include "surrogate_optimizer.h"
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// A quadratic bowl over the parameter box with its peak away from the
+// defaults and the first space-filling points, so the surrogate has to
+// find it
+class QuadraticFitness : public FitnessEvaluator {
+public:
+    static constexpr double kPeak = 3.0;
+    
+    void Evaluate(const std::vector<std::vector<double>>& candidates,
+                  std::vector<double>& fitness) override {
+        const std::vector<double>& lower = EnhancedSnakeOptimizer::getLowerBounds();
+        const std::vector<double>& upper = EnhancedSnakeOptimizer::getUpperBounds();
+        static const double kOptimum[] = {0.55, 0.8, 0.25};
+        fitness.resize(candidates.size());
+        for (size_t i = 0; i < candidates.size(); i++) {
+            double distance = 0.0;
+            for (size_t d = 0; d < candidates[i].size() && d < 3; d++) {
+                double r = (candidates[i][d] - kOptimum[d]) / (upper[d] - lower[d]);
+                distance += r * r;
+            }
+            fitness[i] = kPeak - distance;
+        }
+    }
+    std::string GetName() const override { return "quadratic"; }
+};
+
+// Gaussian process + expected improvement should land near a known optimum
+// on a tight budget: 24 evaluations in rounds of 4, within 0.5% of the peak
+int main() {
+    const uint32_t kEvaluations = 24;
+    const uint32_t kBatch = 4;
+    const double kTolerance = 0.005;
+    
+    QuadraticFitness quadratic;
+    SurrogateOptimizer surrogate(&quadratic);
+    surrogate.setBudget(kEvaluations);
+    surrogate.setBatchSize(kBatch);
+    surrogate.setRandomStream(RngStreamManager::Instance().GetStream("surrogate_optimizer"));
+    surrogate.optimize();
+    
+    double gap = (QuadraticFitness::kPeak - surrogate.getBestFitness()) / QuadraticFitness::kPeak;
+    bool ok = gap <= kTolerance;
+    std::cout << (ok ? "✓" : "✗") << " Surrogate check (" << kEvaluations << " evaluations, " << kBatch
+              << " per round): best " << std::fixed << std::setprecision(4) << surrogate.getBestFitness()
+              << " of " << QuadraticFitness::kPeak << ", " << std::setprecision(3) << gap * 100.0
+              << "% below the optimum (tolerance " << kTolerance * 100.0 << "%)" << std::endl;
+    return ok ? 0 : 1;
+}